@@ -0,0 +1,73 @@
+#include "ActivityFeed.h"
+
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <iostream>
+#include <algorithm>
+
+ActivityFeed::ActivityFeed(const string &name, uint64_t bit_count, uint32_t interval_ms, bool initially_active){
+    this->name = name;
+    header = nullptr;
+    bitmaps = nullptr;
+    size = 0;
+
+    if(name.empty()){
+        return;
+    }
+
+    uint64_t words = (bit_count + 63) / 64;
+    bitmap.assign(words, 0);
+    if(initially_active){
+        fill(bitmap.begin(), bitmap.begin() + bit_count / 64, ~0ULL);
+        if(bit_count % 64){
+            bitmap[words - 1] = (1ULL << (bit_count % 64)) - 1;
+        }
+    }
+    size = ACTIVITY_FEED_DATA_OFFSET + 2 * words * sizeof(uint64_t);
+
+    int fd = shm_open(("/" + name).c_str(), O_CREAT | O_RDWR, 0644);
+    if(fd < 0 || ftruncate(fd, size) != 0){
+        cerr << "Error: Could not create activity feed " << name << ": " << strerror(errno) << endl;
+        exit(1);
+    }
+    void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(data == MAP_FAILED){
+        cerr << "Error: Could not map activity feed " << name << ": " << strerror(errno) << endl;
+        exit(1);
+    }
+    header = (ActivityFeedHeader *) data;
+    bitmaps = (uint64_t *) ((uint8_t *) data + ACTIVITY_FEED_DATA_OFFSET);
+
+    // a restarted controller starts over, but keeps seq going for the
+    // readers that still map the object
+    bool reused = memcmp(header->magic, ACTIVITY_FEED_MAGIC, sizeof(header->magic)) == 0 &&
+                    header->version == ACTIVITY_FEED_VERSION && header->bit_count == bit_count;
+    if(!reused){
+        memcpy(header->magic, ACTIVITY_FEED_MAGIC, sizeof(header->magic));
+        header->version = ACTIVITY_FEED_VERSION;
+        header->data_offset = ACTIVITY_FEED_DATA_OFFSET;
+        header->reserved = 0;
+        header->bit_count = bit_count;
+        header->seq.store(0, memory_order_relaxed);
+    }
+    header->interval_ms = interval_ms;
+    publish();
+}
+
+bool ActivityFeed::enabled(){
+    return header != nullptr;
+}
+
+void ActivityFeed::publish(){
+    if(!enabled()){
+        return;
+    }
+    uint64_t seq = header->seq.load(memory_order_relaxed) + 1;
+    memcpy(bitmaps + (seq & 1) * bitmap.size(), bitmap.data(), bitmap.size() * sizeof(uint64_t));
+    header->seq.store(seq, memory_order_release);
+}
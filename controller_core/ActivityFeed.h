@@ -0,0 +1,84 @@
+#ifndef ACTIVITYFEED_H // Include guards to prevent multiple inclusion
+
+#define ACTIVITYFEED_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <atomic>
+
+#define ACTIVITY_FEED_MAGIC "TACT"
+#define ACTIVITY_FEED_VERSION 1
+// the bitmaps start on their own cache line
+#define ACTIVITY_FEED_DATA_OFFSET 64
+
+using namespace std;
+
+// start of the shared memory object
+struct ActivityFeedHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t data_offset;       // of the first bitmap
+    uint32_t interval_ms;       // time between two epochs
+    uint32_t reserved;
+    uint64_t bit_count;         // address indices per bitmap
+    atomic<uint64_t> seq;       // epochs published; bitmap seq & 1 is the latest
+};
+
+static_assert(sizeof(ActivityFeedHeader) <= ACTIVITY_FEED_DATA_OFFSET, "header overlaps the bitmaps");
+
+/*
+ * Activity state of every monitored address, published to the capture
+ * application through POSIX shared memory (dpdk-buffer/state_feed.h has
+ * the same layout).
+ *
+ * The object holds two bitmaps with one bit per address index, set while
+ * the address is active. publish() copies the state into the bitmap that
+ * readers are not using and then bumps seq, so a reader that loads seq
+ * and reads bitmap seq & 1 sees a whole epoch; that bitmap is rewritten
+ * only one epoch later.
+ */
+class ActivityFeed {
+    private:
+        string name;
+        ActivityFeedHeader *header;
+        uint64_t *bitmaps;
+        size_t size;
+        // state of the epoch being processed
+        vector<uint64_t> bitmap;
+    public:
+        // an empty name disables the feed; every address starts active if initially_active is set
+        ActivityFeed(const string &name, uint64_t bit_count, uint32_t interval_ms, bool initially_active);
+
+        bool enabled();
+
+        // sets (active) or clears the bit of STRIDE * i + offset for every i in indices;
+        // concurrent calls must not touch the same 64-bit word
+        template <uint32_t STRIDE>
+        void update(const vector<uint32_t> &indices, uint32_t offset, bool active);
+
+        // makes the state visible to the readers; called between epochs, not concurrently with update()
+        void publish();
+};
+
+template <uint32_t STRIDE>
+void ActivityFeed::update(const vector<uint32_t> &indices, uint32_t offset, bool active){
+    if(!enabled()){
+        return;
+    }
+    if(active){
+        for(uint32_t i: indices){
+            uint64_t bit = (uint64_t) STRIDE * i + offset;
+            bitmap[bit >> 6] |= 1ULL << (bit & 63);
+        }
+    }
+    else{
+        for(uint32_t i: indices){
+            uint64_t bit = (uint64_t) STRIDE * i + offset;
+            bitmap[bit >> 6] &= ~(1ULL << (bit & 63));
+        }
+    }
+}
+
+#endif // ACTIVITYFEED_H
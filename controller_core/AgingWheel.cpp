@@ -0,0 +1,162 @@
+#include "AgingWheel.h"
+
+AgingWheel::AgingWheel(uint32_t n, uint16_t alpha, uint32_t meter_shift)
+        : level0(WHEEL_SLOTS), level1(WHEEL_SLOTS) {
+    this->n = n;
+    this->alpha = alpha;
+    this->meter_shift = meter_shift;
+
+    epoch = 2;
+    // only the meters of this bank part; a shard must not add into its neighbour's
+    inactive_per_meter.assign((n + (1u << meter_shift) - 1) >> meter_shift, 0);
+
+    if(alpha == 0){
+        // counters start at 0: everything is inactive and nothing transitions
+        last_active.assign(n, WHEEL_EXPIRED);
+        for(uint32_t i = 0; i < n; i++){
+            inactive_per_meter[i >> meter_shift]++;
+        }
+        inactive_addr = n;
+        initial_expired = true;
+    }
+    else{
+        // the initial cohort is not put in the wheel, it expires in one sweep
+        last_active.assign(n, 0);
+        inactive_addr = 0;
+        initial_expired = false;
+    }
+}
+
+void AgingWheel::schedule(uint32_t idx, uint32_t expiry){
+    if(expiry - epoch < WHEEL_SLOTS){
+        level0[expiry % WHEEL_SLOTS].push_back(idx);
+    }
+    else{
+        level1[(expiry / WHEEL_SLOTS) % WHEEL_SLOTS].push_back(idx);
+    }
+}
+
+void AgingWheel::expire(uint32_t idx, BankUpdate &out){
+    last_active[idx] = WHEEL_EXPIRED;
+    out.inactive_indices.push_back(idx);
+    inactive_per_meter[idx >> meter_shift]++;
+    inactive_addr++;
+}
+
+void AgingWheel::update(const uint64_t *flags, uint32_t *inactive_pfxs, BankUpdate &out){
+    // bring the level 1 slot of this block down to level 0
+    if(epoch % WHEEL_SLOTS == 0){
+        fired.clear();
+        fired.swap(level1[(epoch / WHEEL_SLOTS) % WHEEL_SLOTS]);
+        for(auto idx: fired){
+            schedule(idx, last_active[idx] + alpha + 1);
+        }
+    }
+
+    // flagged indices restart their window
+    for(uint32_t w = 0; w < (n + 63) / 64; w++){
+        uint64_t word = flags[w];
+        while(word){
+            uint32_t idx = w * 64 + __builtin_ctzll(word);
+            word &= word - 1;
+            if(idx >= n){
+                break;
+            }
+
+            out.flag_indices.push_back(idx);
+            out.cur_active_addr_cnt++;
+
+            if(last_active[idx] == WHEEL_EXPIRED){
+                out.global_indices.push_back(idx);
+                inactive_per_meter[idx >> meter_shift]--;
+                inactive_addr--;
+                schedule(idx, epoch + alpha + 1);
+            }
+            else if(last_active[idx] == 0){
+                schedule(idx, epoch + alpha + 1);
+            }
+            last_active[idx] = epoch;
+        }
+    }
+
+    // fire this epoch's slot; entries flagged since they were parked move on
+    fired.clear();
+    fired.swap(level0[epoch % WHEEL_SLOTS]);
+    for(auto idx: fired){
+        uint32_t expiry = last_active[idx] + alpha + 1;
+        if(expiry == epoch){
+            expire(idx, out);
+        }
+        else{
+            schedule(idx, expiry);
+        }
+    }
+
+    // indices never flagged since startup
+    if(!initial_expired && epoch == (uint32_t) alpha + 1){
+        for(uint32_t i = 0; i < n; i++){
+            if(last_active[i] == 0){
+                expire(i, out);
+            }
+        }
+        initial_expired = true;
+    }
+
+    // held indices are no event of the wheel, collecting them walks the bank
+    if(out.collect_hold){
+        for(uint32_t i = 0; i < n; i++){
+            if(last_active[i] != WHEEL_EXPIRED && last_active[i] != epoch){
+                out.hold_indices.push_back(i);
+            }
+        }
+    }
+
+    out.inactive_addr += inactive_addr;
+    out.active_addr_cnt += n - inactive_addr;
+    if(inactive_pfxs != nullptr){
+        for(uint32_t m = 0; m < inactive_per_meter.size(); m++){
+            inactive_pfxs[m] += inactive_per_meter[m];
+        }
+    }
+
+    epoch++;
+}
+
+/*
+ * After update() has run for epoch e - 1 (this->epoch is e), an index
+ * last flagged in epoch a has a counter of alpha + 1 - (e - 1 - a). The
+ * initial cohort has a = 0 and expired indices have a counter of 0.
+ */
+void AgingWheel::get_counters(uint16_t *counters, uint32_t stride){
+    for(uint32_t i = 0; i < n; i++){
+        counters[(uint64_t) stride * i] = last_active[i] == WHEEL_EXPIRED ? 0 : last_active[i] + alpha + 2 - epoch;
+    }
+}
+
+void AgingWheel::set_counters(const uint16_t *counters, uint32_t stride){
+    for(auto &slot: level0){
+        slot.clear();
+    }
+    for(auto &slot: level1){
+        slot.clear();
+    }
+
+    // far enough from 0 that every restored index gets a flag epoch a > 0
+    epoch = (uint32_t) alpha + 3;
+    initial_expired = true;
+    inactive_addr = 0;
+    inactive_per_meter.assign(inactive_per_meter.size(), 0);
+
+    for(uint32_t i = 0; i < n; i++){
+        uint16_t counter = counters[(uint64_t) stride * i];
+        if(counter == 0){
+            last_active[i] = WHEEL_EXPIRED;
+            inactive_per_meter[i >> meter_shift]++;
+            inactive_addr++;
+        }
+        else{
+            last_active[i] = epoch + counter - alpha - 2;
+            schedule(i, last_active[i] + alpha + 1);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef AGINGWHEEL_H // Include guards to prevent multiple inclusion
+
+#define AGINGWHEEL_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "EpochKernel.h"
+
+// slots per wheel level; two levels cover windows of up to 2^16 epochs
+#define WHEEL_SLOTS 256
+#define WHEEL_EXPIRED UINT32_MAX
+
+using namespace std;
+
+/*
+ * Event-driven replacement for the per-address counters of one bank.
+ *
+ * Each index keeps the epoch in which it was last flagged and is parked in
+ * a two-level timing wheel under the epoch in which its alpha window runs
+ * out. An epoch only touches the flagged indices and the wheel slot that
+ * fires, so the transitions match epoch_update() without walking the bank.
+ */
+class AgingWheel {
+    private:
+        uint32_t n;
+        uint16_t alpha;
+        uint32_t meter_shift;
+
+        // epochs start at 2 so that the initial counters of alpha
+        // behave as if every index was flagged in epoch 0
+        uint32_t epoch;
+        bool initial_expired;
+
+        // last epoch each index was flagged in, WHEEL_EXPIRED once inactive
+        vector<uint32_t> last_active;
+
+        // level 0 slots are single epochs, level 1 slots span WHEEL_SLOTS epochs
+        vector<vector<uint32_t>> level0;
+        vector<vector<uint32_t>> level1;
+        vector<uint32_t> fired;
+
+        // inactive indices in total and per dark_meter index
+        uint32_t inactive_addr;
+        vector<uint32_t> inactive_per_meter;
+
+        void schedule(uint32_t idx, uint32_t expiry);
+
+        void expire(uint32_t idx, BankUpdate &out);
+    public:
+        AgingWheel(uint32_t n, uint16_t alpha, uint32_t meter_shift);
+
+        // same contract as epoch_update() without the counters array
+        void update(const uint64_t *flags, uint32_t *inactive_pfxs, BankUpdate &out);
+
+        // writes the counter epoch_update() would hold for index i to counters[stride * i]
+        void get_counters(uint16_t *counters, uint32_t stride);
+
+        // restarts the wheel from the counters[stride * i] of every index i,
+        // which are at most alpha + 1 as get_counters() writes them
+        void set_counters(const uint16_t *counters, uint32_t stride);
+};
+
+#endif // AGINGWHEEL_H
@@ -0,0 +1,59 @@
+#ifndef BACKEND_H // Include guards to prevent multiple inclusion
+
+#define BACKEND_H
+
+#include <string>
+#include <memory>
+
+#include "Register.h"
+#include "Meter.h"
+#include "MonitoredTable.h"
+#include "ForwardTable.h"
+#include "PortsTable.h"
+#include "MirrorManager.h"
+#include "Node.h"
+#include "MulticastGroup.h"
+#include "PortManager.h"
+#include "FlagDigest.h"
+
+using namespace std;
+
+// session of a backend; tables write through the session they were created with
+class BackendSession {
+    public:
+        virtual ~BackendSession() {}
+};
+
+/*
+ * Creates the tables the controller programs. BfRtBackend talks to the
+ * switch through BfRt, SimSwitch keeps the tables in memory so that the
+ * controller runs without an SDE.
+ */
+class Backend {
+    public:
+        virtual ~Backend() {}
+
+        virtual shared_ptr<BackendSession> session_create() = 0;
+
+        virtual Register *new_register(const string &name, shared_ptr<BackendSession> session) = 0;
+
+        virtual Meter *new_meter(const string &name, shared_ptr<BackendSession> session) = 0;
+
+        virtual MonitoredTable *new_monitored_table(shared_ptr<BackendSession> session) = 0;
+
+        virtual ForwardTable *new_forward_table(shared_ptr<BackendSession> session) = 0;
+
+        virtual PortsTable *new_ports_table(shared_ptr<BackendSession> session) = 0;
+
+        virtual MirrorManager *new_mirror_manager(shared_ptr<BackendSession> session) = 0;
+
+        virtual Node *new_node(shared_ptr<BackendSession> session) = 0;
+
+        virtual MulticastGroup *new_multicast_group(shared_ptr<BackendSession> session) = 0;
+
+        virtual PortManager *new_port_manager(shared_ptr<BackendSession> session) = 0;
+
+        virtual FlagDigest *new_flag_digest(shared_ptr<BackendSession> session) = 0;
+};
+
+#endif // BACKEND_H
\ No newline at end of file
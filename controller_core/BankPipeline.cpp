@@ -0,0 +1,18 @@
+#include "BankPipeline.h"
+
+BankPipeline::BankPipeline(uint32_t banks){
+    this->banks = banks;
+}
+
+void BankPipeline::run(const function<void(uint32_t, vector<uint64_t> &)> &read,
+                        const function<void(uint32_t, const vector<uint64_t> &)> &process){
+    future<void> next = async(launch::async, [&]{ read(0, bitmaps[0]); });
+
+    for(uint32_t b = 0; b < banks; b++){
+        next.get();
+        if(b + 1 < banks){
+            next = async(launch::async, [&, b]{ read(b + 1, bitmaps[(b + 1) % 2]); });
+        }
+        process(b, bitmaps[b % 2]);
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef BANKPIPELINE_H // Include guards to prevent multiple inclusion
+
+#define BANKPIPELINE_H
+
+#include <stdint.h>
+#include <vector>
+#include <future>
+#include <functional>
+
+using namespace std;
+
+/*
+ * Runs the register banks of one epoch as a two-stage pipeline: read()
+ * syncs and fetches bank N + 1 on its own thread while process() computes
+ * and writes back bank N, so an epoch takes roughly banks * max(read, process)
+ * instead of banks * (read + process).
+ *
+ * The two stages run concurrently and must use separate BfRt sessions and
+ * Register objects.
+ */
+class BankPipeline {
+    private:
+        uint32_t banks;
+        // read() fills one bitmap while process() consumes the other
+        vector<uint64_t> bitmaps[2];
+    public:
+        BankPipeline(uint32_t banks);
+
+        void run(const function<void(uint32_t, vector<uint64_t> &)> &read,
+                    const function<void(uint32_t, const vector<uint64_t> &)> &process);
+};
+
+#endif // BANKPIPELINE_H
@@ -0,0 +1,57 @@
+#include "BfRtBackend.h"
+
+BfRtBackend::BfRtBackend(bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info){
+    this->dev_tgt = dev_tgt;
+    this->bf_rt_info = bf_rt_info;
+}
+
+shared_ptr<BfRtSession> BfRtBackend::bfrt_session(shared_ptr<BackendSession> session){
+    return static_pointer_cast<BfRtBackendSession>(session)->session;
+}
+
+shared_ptr<BackendSession> BfRtBackend::session_create(){
+    shared_ptr<BfRtBackendSession> backend_session = make_shared<BfRtBackendSession>();
+    backend_session->session = BfRtSession::sessionCreate();
+    bf_sys_assert(backend_session->session != nullptr);
+    return backend_session;
+}
+
+Register *BfRtBackend::new_register(const string &name, shared_ptr<BackendSession> session){
+    return new BfRtRegister(name, bfrt_session(session), dev_tgt, bf_rt_info);
+}
+
+Meter *BfRtBackend::new_meter(const string &name, shared_ptr<BackendSession> session){
+    return new BfRtMeter(name, bfrt_session(session), dev_tgt, bf_rt_info);
+}
+
+MonitoredTable *BfRtBackend::new_monitored_table(shared_ptr<BackendSession> session){
+    return new BfRtMonitoredTable(bfrt_session(session), dev_tgt, bf_rt_info);
+}
+
+ForwardTable *BfRtBackend::new_forward_table(shared_ptr<BackendSession> session){
+    return new BfRtForwardTable(bfrt_session(session), dev_tgt, bf_rt_info);
+}
+
+PortsTable *BfRtBackend::new_ports_table(shared_ptr<BackendSession> session){
+    return new BfRtPortsTable(bfrt_session(session), dev_tgt, bf_rt_info);
+}
+
+MirrorManager *BfRtBackend::new_mirror_manager(shared_ptr<BackendSession> session){
+    return new BfRtMirrorManager(bfrt_session(session), dev_tgt, bf_rt_info);
+}
+
+Node *BfRtBackend::new_node(shared_ptr<BackendSession> session){
+    return new BfRtNode(bfrt_session(session), dev_tgt, bf_rt_info);
+}
+
+MulticastGroup *BfRtBackend::new_multicast_group(shared_ptr<BackendSession> session){
+    return new BfRtMulticastGroup(bfrt_session(session), dev_tgt, bf_rt_info);
+}
+
+PortManager *BfRtBackend::new_port_manager(shared_ptr<BackendSession> session){
+    return new BfRtPortManager(bfrt_session(session), dev_tgt, bf_rt_info);
+}
+
+FlagDigest *BfRtBackend::new_flag_digest(shared_ptr<BackendSession> session){
+    return new BfRtFlagDigest(bfrt_session(session), dev_tgt, bf_rt_info);
+}
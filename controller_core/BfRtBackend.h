@@ -0,0 +1,70 @@
+#ifndef BFRTBACKEND_H // Include guards to prevent multiple inclusion
+
+#define BFRTBACKEND_H
+
+#include <bf_rt/bf_rt.hpp>
+#include <bf_rt/bf_rt_info.hpp>
+#include <bf_rt/bf_rt_init.hpp>
+#include <bf_rt/bf_rt_learn.hpp>
+#include <bf_rt/bf_rt_session.hpp>
+#include <bf_rt/bf_rt_table_attributes.hpp>
+#include <bf_rt/bf_rt_table_data.hpp>
+#include <bf_rt/bf_rt_table.hpp>
+#include <bf_rt/bf_rt_table_key.hpp>
+#include <bf_rt/bf_rt_table_operations.hpp>
+
+#include "Backend.h"
+#include "BfRtRegister.h"
+#include "BfRtMeter.h"
+#include "BfRtMonitoredTable.h"
+#include "BfRtForwardTable.h"
+#include "BfRtPortsTable.h"
+#include "BfRtMirrorManager.h"
+#include "BfRtNode.h"
+#include "BfRtMulticastGroup.h"
+#include "BfRtPortManager.h"
+#include "BfRtFlagDigest.h"
+
+using namespace std;
+
+using namespace bfrt;
+
+class BfRtBackendSession : public BackendSession {
+    public:
+        shared_ptr<BfRtSession> session;
+};
+
+// tables on the switch of dev_tgt, programmed through BfRt
+class BfRtBackend : public Backend {
+    private:
+        bf_rt_target_t dev_tgt;
+        const BfRtInfo *bf_rt_info;
+
+        static shared_ptr<BfRtSession> bfrt_session(shared_ptr<BackendSession> session);
+    public:
+        BfRtBackend(bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
+
+        shared_ptr<BackendSession> session_create();
+
+        Register *new_register(const string &name, shared_ptr<BackendSession> session);
+
+        Meter *new_meter(const string &name, shared_ptr<BackendSession> session);
+
+        MonitoredTable *new_monitored_table(shared_ptr<BackendSession> session);
+
+        ForwardTable *new_forward_table(shared_ptr<BackendSession> session);
+
+        PortsTable *new_ports_table(shared_ptr<BackendSession> session);
+
+        MirrorManager *new_mirror_manager(shared_ptr<BackendSession> session);
+
+        Node *new_node(shared_ptr<BackendSession> session);
+
+        MulticastGroup *new_multicast_group(shared_ptr<BackendSession> session);
+
+        PortManager *new_port_manager(shared_ptr<BackendSession> session);
+
+        FlagDigest *new_flag_digest(shared_ptr<BackendSession> session);
+};
+
+#endif // BFRTBACKEND_H
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "BfRtFlagDigest.h"
+
+BfRtFlagDigest::BfRtFlagDigest(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info){
+    this->session = session;
+    this->dev_tgt = dev_tgt;
+    skipped = 0;
+
+    // get the digest and its fields
+    bf_status = bf_rt_info->bfrtLearnFromNameGet("pipe.IngressDeparser.flag_digest", &learn);
+    bf_sys_assert(bf_status == BF_SUCCESS);
+    bf_status = learn->learnFieldIdGet("idx", &idx_id);
+    bf_sys_assert(bf_status == BF_SUCCESS);
+    bf_status = learn->learnFieldIdGet("bank", &bank_id);
+    bf_sys_assert(bf_status == BF_SUCCESS);
+}
+
+void BfRtFlagDigest::subscribe(FlagDigestCallback callback){
+    this->callback = callback;
+
+    bf_status = learn->bfRtLearnCallbackRegister(session, dev_tgt, BfRtFlagDigest::learn_callback, this);
+    bf_sys_assert(bf_status == BF_SUCCESS);
+}
+
+// runs on the learn thread of the driver for every digest message
+bf_status_t BfRtFlagDigest::learn_callback(const bf_rt_target_t &, const shared_ptr<BfRtSession> session,
+                                            vector<unique_ptr<BfRtLearnData>> learn_data,
+                                            bf_rt_learn_msg_hdl *const learn_msg_hdl, const void *cookie){
+    BfRtFlagDigest *digest = (BfRtFlagDigest *) cookie;
+    uint64_t idx, bank;
+
+    digest->events.clear();
+    for(auto &data: learn_data){
+        // skip the digests the driver cannot decode; the next reconcile scan finds their flags
+        if(data->getValue(digest->idx_id, &idx) != BF_SUCCESS ||
+           data->getValue(digest->bank_id, &bank) != BF_SUCCESS){
+            digest->skipped.fetch_add(1, memory_order_relaxed);
+            continue;
+        }
+        digest->events.push_back({(uint32_t) idx, (uint32_t) bank});
+    }
+    digest->callback(digest->events);
+
+    // the driver reuses the message once it is acknowledged
+    return digest->learn->bfRtLearnNotifyAck(session, learn_msg_hdl);
+}
+
+uint64_t BfRtFlagDigest::take_skipped(){
+    return skipped.exchange(0, memory_order_relaxed);
+}
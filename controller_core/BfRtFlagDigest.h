@@ -0,0 +1,48 @@
+#ifndef BFRTFLAGDIGEST_H // Include guards to prevent multiple inclusion
+
+#define BFRTFLAGDIGEST_H
+
+#include <bf_rt/bf_rt.hpp>
+#include <bf_rt/bf_rt_info.hpp>
+#include <bf_rt/bf_rt_init.hpp>
+#include <bf_rt/bf_rt_learn.hpp>
+#include <bf_rt/bf_rt_session.hpp>
+#include <bf_rt/bf_rt_table_attributes.hpp>
+#include <bf_rt/bf_rt_table_data.hpp>
+#include <bf_rt/bf_rt_table.hpp>
+#include <bf_rt/bf_rt_table_key.hpp>
+#include <bf_rt/bf_rt_table_operations.hpp>
+
+#include <atomic>
+
+#include "FlagDigest.h"
+
+using namespace std;
+using namespace bfrt;
+
+class BfRtFlagDigest : public FlagDigest {
+    private:
+        bf_status_t bf_status;
+        shared_ptr<BfRtSession> session;
+        bf_rt_target_t dev_tgt;
+
+        const BfRtLearn *learn;
+        bf_rt_id_t idx_id, bank_id;
+
+        FlagDigestCallback callback;
+        atomic<uint64_t> skipped;
+        // events of the message being handled; only the learn thread touches it
+        vector<FlagEvent> events;
+
+        static bf_status_t learn_callback(const bf_rt_target_t &dev_tgt, const shared_ptr<BfRtSession> session,
+                                            vector<unique_ptr<BfRtLearnData>> learn_data,
+                                            bf_rt_learn_msg_hdl *const learn_msg_hdl, const void *cookie);
+    public:
+        BfRtFlagDigest(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
+
+        void subscribe(FlagDigestCallback callback);
+
+        uint64_t take_skipped();
+};
+
+#endif
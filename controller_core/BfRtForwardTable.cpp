@@ -1,6 +1,6 @@
-#include "ForwardTable.h"
+#include "BfRtForwardTable.h"
 
- ForwardTable::ForwardTable(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info){
+ BfRtForwardTable::BfRtForwardTable(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info){
     this->session = session;
     this->dev_tgt = dev_tgt;
 
@@ -29,7 +29,7 @@
     bf_sys_assert(bf_status == BF_SUCCESS);
 }
 
-void ForwardTable::add_entry(const uint16_t &ingress_port, const uint16_t &egress_port){
+void BfRtForwardTable::add_entry(const uint16_t &ingress_port, const uint16_t &egress_port){
     // reset
     bf_status = forward_table->keyReset(_key.get());
     bf_sys_assert(bf_status == BF_SUCCESS);
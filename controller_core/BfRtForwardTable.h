@@ -1,6 +1,6 @@
-#ifndef FORWARDTABLE_H // Include guards to prevent multiple inclusion
+#ifndef BFRTFORWARDTABLE_H // Include guards to prevent multiple inclusion
 
-#define FORWARDTABLE_H
+#define BFRTFORWARDTABLE_H
 
 #include <bf_rt/bf_rt.hpp>
 #include <bf_rt/bf_rt_info.hpp>
@@ -13,10 +13,12 @@
 #include <bf_rt/bf_rt_table_key.hpp>
 #include <bf_rt/bf_rt_table_operations.hpp>
 
+#include "ForwardTable.h"
+
 using namespace std;
 using namespace bfrt;
 
-class ForwardTable {
+class BfRtForwardTable : public ForwardTable {
     private:
         bf_status_t bf_status;
         // keep session, dev_tgt since we need it in many funcs
@@ -31,10 +33,10 @@ class ForwardTable {
         // action/key/data ID
         bf_rt_id_t set_port_id, ingress_port_id, egress_port_id;
     public:
-        ForwardTable(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
+        BfRtForwardTable(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
 
         void add_entry(const uint16_t &ingress_port,
                         const uint16_t &egress_port);
 };
 
-#endif // FORWARDTABLE_H
\ No newline at end of file
+#endif // BFRTFORWARDTABLE_H
\ No newline at end of file
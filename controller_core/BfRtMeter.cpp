@@ -1,6 +1,6 @@
-#include "Meter.h"
+#include "BfRtMeter.h"
 
-Meter::Meter(const string &name, shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info){
+BfRtMeter::BfRtMeter(const string &name, shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info){
     this->session = session;
     this->dev_tgt = dev_tgt;
 
@@ -33,7 +33,7 @@ Meter::Meter(const string &name, shared_ptr<BfRtSession> session, bf_rt_target_t
     bf_sys_assert(bf_status == BF_SUCCESS);
 }
 
-void Meter::add_entry(const uint32_t &avg_pkt_rate, const uint32_t &max_pkt_rate, const uint32_t &idx){
+void BfRtMeter::set_entry(const uint32_t &avg_pkt_rate, const uint32_t &max_pkt_rate, const uint32_t &idx){
     // reset
     bf_status = meter_table->keyReset(_key.get());
     bf_sys_assert(bf_status == BF_SUCCESS);
@@ -51,7 +51,28 @@ void Meter::add_entry(const uint32_t &avg_pkt_rate, const uint32_t &max_pkt_rate
     bf_sys_assert(bf_status == BF_SUCCESS);
     bf_status = _data->setValue(pbs_pkts_id, (uint64_t) 100);
     bf_sys_assert(bf_status == BF_SUCCESS);
+}
+
+void BfRtMeter::add_entry(const uint32_t &avg_pkt_rate, const uint32_t &max_pkt_rate, const uint32_t &idx){
+    set_entry(avg_pkt_rate, max_pkt_rate, idx);
 
     bf_status = meter_table->tableEntryAdd(*session, dev_tgt, *_key, *_data);
     bf_sys_assert(bf_status == BF_SUCCESS);
+}
+
+void BfRtMeter::add_entries(const vector<MeterEntry> &entries){
+    // begin batch
+    bf_status = session->beginBatch();
+    bf_sys_assert(bf_status == BF_SUCCESS);
+
+    for(auto &entry: entries){
+        set_entry(entry.avg_pkt_rate, entry.max_pkt_rate, entry.idx);
+
+        bf_status = meter_table->tableEntryAdd(*session, dev_tgt, *_key, *_data);
+        bf_sys_assert(bf_status == BF_SUCCESS);
+    }
+
+    // end batch
+    bf_status = session->endBatch(true);
+    bf_sys_assert(bf_status == BF_SUCCESS);
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
-#ifndef METER_H // Include guards to prevent multiple inclusion
+#ifndef BFRTMETER_H // Include guards to prevent multiple inclusion
 
-#define METER_H
+#define BFRTMETER_H
 
 #include <bf_rt/bf_rt.hpp>
 #include <bf_rt/bf_rt_info.hpp>
@@ -13,10 +13,12 @@
 #include <bf_rt/bf_rt_table_key.hpp>
 #include <bf_rt/bf_rt_table_operations.hpp>
 
+#include "Meter.h"
+
 using namespace std;
 using namespace bfrt;
 
-class Meter{
+class BfRtMeter : public Meter {
     private:
         bf_status_t bf_status;
         // keep session, dev_tgt since we need it in many funcs
@@ -31,10 +33,15 @@ class Meter{
         unique_ptr<BfRtTableData> _data;
         bf_rt_id_t meter_index_id;
         bf_rt_id_t cir_pps_id, pir_pps_id, cbs_pkts_id, pbs_pkts_id;
+
+        // fills _key and _data for one entry
+        void set_entry(const uint32_t &avg_pkt_rate, const uint32_t &max_pkt_rate, const uint32_t &idx);
     public:
-        Meter(const string &name, shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
+        BfRtMeter(const string &name, shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
 
         void add_entry(const uint32_t &avg_pkt_rate, const uint32_t &max_pkt_rate, const uint32_t &idx);
+
+        void add_entries(const vector<MeterEntry> &entries);
 };
 
 #endif
\ No newline at end of file
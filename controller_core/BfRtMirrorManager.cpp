@@ -1,6 +1,6 @@
-#include "MirrorManager.h"
+#include "BfRtMirrorManager.h"
 
-MirrorManager::MirrorManager(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info) {
+BfRtMirrorManager::BfRtMirrorManager(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info) {
     this->session = session;
     this->dev_tgt = dev_tgt;
     
@@ -41,7 +41,7 @@ MirrorManager::MirrorManager(shared_ptr<BfRtSession> session, bf_rt_target_t dev
     bf_sys_assert(bf_status == BF_SUCCESS);
 }
 
-void MirrorManager::add_mirror_port(uint16_t sid, uint16_t port) {
+void BfRtMirrorManager::add_mirror_port(uint16_t sid, uint16_t port) {
     // reset
     bf_status = mirror_cfg->keyReset(_key.get());
     bf_sys_assert(bf_status == BF_SUCCESS);
@@ -64,7 +64,7 @@ void MirrorManager::add_mirror_port(uint16_t sid, uint16_t port) {
     bf_sys_assert(bf_status == BF_SUCCESS);
 }
 
-void MirrorManager::add_mirror_group(uint16_t sid, uint16_t grp_a, uint16_t grp_b, uint16_t pkt_len) {
+void BfRtMirrorManager::add_mirror_group(uint16_t sid, uint16_t grp_a, uint16_t grp_b, uint16_t pkt_len) {
     // reset
     bf_status = mirror_cfg->keyReset(_key.get());
     bf_sys_assert(bf_status == BF_SUCCESS);
@@ -1,6 +1,6 @@
-#ifndef MIRRORMGR_H // Include guards to prevent multiple inclusion
+#ifndef BFRTMIRRORMGR_H // Include guards to prevent multiple inclusion
 
-#define MIRRORMGR_H
+#define BFRTMIRRORMGR_H
 
 #include <bf_rt/bf_rt.hpp>
 #include <bf_rt/bf_rt_info.hpp>
@@ -13,10 +13,12 @@
 #include <bf_rt/bf_rt_table_key.hpp>
 #include <bf_rt/bf_rt_table_operations.hpp>
 
+#include "MirrorManager.h"
+
 using namespace std;
 using namespace bfrt;
 
-class MirrorManager {
+class BfRtMirrorManager : public MirrorManager {
     private:
         bf_status_t bf_status;
         // keep session, dev_tgt since we need it in many funcs
@@ -33,7 +35,7 @@ class MirrorManager {
         bf_rt_id_t direction_id, sess_en_id, egress_port_id, egress_port_val_id;
         bf_rt_id_t mcast_rid, mcast_grp_a, mcast_grp_a_valid, mcast_grp_b, mcast_grp_b_valid, max_pkt_len;
     public:
-        MirrorManager(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
+        BfRtMirrorManager(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
 
         void add_mirror_port(uint16_t sid, uint16_t port);
 
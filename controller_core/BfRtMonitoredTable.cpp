@@ -1,7 +1,6 @@
-#include "MonitoredTable.h"
+#include "BfRtMonitoredTable.h"
 
-
- MonitoredTable::MonitoredTable(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info){
+ BfRtMonitoredTable::BfRtMonitoredTable(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info){
     this->session = session;
     this->dev_tgt = dev_tgt;
 
@@ -24,6 +23,8 @@
     bf_sys_assert(bf_status == BF_SUCCESS);
     bf_status = monitored_table->dataFieldIdGet("mask", calc_idx_id, &mask_id);
     bf_sys_assert(bf_status == BF_SUCCESS);
+    // tofino/ipv6 has no dark_meter
+    has_dark_base_idx = monitored_table->dataFieldIdGet("dark_base_idx", calc_idx_id, &dark_base_idx_id) == BF_SUCCESS;
 
     // allocate key and data
     bf_status = monitored_table->keyAllocate(&_key);
@@ -32,7 +33,8 @@
     bf_sys_assert(bf_status == BF_SUCCESS);
 }
 
-void MonitoredTable::add_entry(string &prefix, string &length, uint32_t &base_idx, uint32_t &mask){
+void BfRtMonitoredTable::add_entry(const vector<uint8_t> &prefix, uint16_t length, uint32_t base_idx,
+                uint32_t mask, uint32_t dark_base_idx){
     // reset
     bf_status = monitored_table->keyReset(_key.get());
     bf_sys_assert(bf_status == BF_SUCCESS);
@@ -40,16 +42,16 @@ void MonitoredTable::add_entry(string &prefix, string &length, uint32_t &base_id
     bf_sys_assert(bf_status == BF_SUCCESS);
 
     // set values
-    uint8_t fixed_length = (uint8_t) stoi(length);
-    struct in6_addr fixed_prefix;
-    inet_pton(AF_INET6, prefix.c_str(), &fixed_prefix);
-
-    bf_status = _key->setValueLpm(meta_addr_id, reinterpret_cast<const uint8_t *>(&fixed_prefix), (uint16_t) fixed_length, sizeof(in6_addr));
+    bf_status = _key->setValueLpm(meta_addr_id, prefix.data(), length, prefix.size());
     bf_sys_assert(bf_status == BF_SUCCESS);
     bf_status = _data->setValue(base_idx_id, (uint64_t) base_idx);
     bf_sys_assert(bf_status == BF_SUCCESS);
     bf_status = _data->setValue(mask_id, (uint64_t) mask);
     bf_sys_assert(bf_status == BF_SUCCESS);
+    if(has_dark_base_idx){
+        bf_status = _data->setValue(dark_base_idx_id, (uint64_t) dark_base_idx);
+        bf_sys_assert(bf_status == BF_SUCCESS);
+    }
 
     bf_status = monitored_table->tableEntryAdd(*session, dev_tgt, *_key, *_data);
     bf_sys_assert(bf_status == BF_SUCCESS);
@@ -1,6 +1,6 @@
-#ifndef MONITOREDTABLE_H // Include guards to prevent multiple inclusion
+#ifndef BFRTMONITOREDTABLE_H // Include guards to prevent multiple inclusion
 
-#define MONITOREDTABLE_H
+#define BFRTMONITOREDTABLE_H
 
 #include <bf_rt/bf_rt.hpp>
 #include <bf_rt/bf_rt_info.hpp>
@@ -13,12 +13,12 @@
 #include <bf_rt/bf_rt_table_key.hpp>
 #include <bf_rt/bf_rt_table_operations.hpp>
 
+#include "MonitoredTable.h"
+
 using namespace std;
 using namespace bfrt;
 
-uint32_t ipv4_to_bytes(const char* ipv4, uint8_t* pref_len=nullptr);
-
-class MonitoredTable{
+class BfRtMonitoredTable : public MonitoredTable {
     private:
         bf_status_t bf_status;
         // keep session, dev_tgt since we need it in many funcs
@@ -35,14 +35,15 @@ class MonitoredTable{
         // action/key/data IDs
         bf_rt_id_t calc_idx_id, meta_addr_id;
         bf_rt_id_t base_idx_id, mask_id, dark_base_idx_id;
+        bool has_dark_base_idx;
     public:
-        MonitoredTable(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
+        BfRtMonitoredTable(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
 
-        void add_entry(string &prefix,
-                        string &length,
-                        uint32_t &base_idx,
-                        uint32_t &mask,
-                        uint32_t &dark_base_idx);
+        void add_entry(const vector<uint8_t> &prefix,
+                        uint16_t length,
+                        uint32_t base_idx,
+                        uint32_t mask,
+                        uint32_t dark_base_idx);
 };
 
-#endif // MONITOREDTABLE_H
\ No newline at end of file
+#endif // BFRTMONITOREDTABLE_H
\ No newline at end of file
@@ -1,6 +1,6 @@
-#include "MulticastGroup.h"
+#include "BfRtMulticastGroup.h"
 
-MulticastGroup::MulticastGroup(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info) {
+BfRtMulticastGroup::BfRtMulticastGroup(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info) {
     this->session = session;
     this->dev_tgt = dev_tgt;
     
@@ -25,7 +25,7 @@ MulticastGroup::MulticastGroup(shared_ptr<BfRtSession> session, bf_rt_target_t d
     bf_sys_assert(bf_status == BF_SUCCESS);
 }
 
-void MulticastGroup::add_group(uint16_t group_id, vector<uint16_t> rids) {
+void BfRtMulticastGroup::add_group(uint16_t group_id, vector<uint16_t> rids) {
     // reset
     bf_status = group->keyReset(_key.get());
     bf_sys_assert(bf_status == BF_SUCCESS);
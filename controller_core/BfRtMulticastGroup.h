@@ -1,6 +1,6 @@
-#ifndef MULTICASTGROUP_H // Include guards to prevent multiple inclusion
+#ifndef BFRTMULTICASTGROUP_H // Include guards to prevent multiple inclusion
 
-#define MULTICASTGROUP_H
+#define BFRTMULTICASTGROUP_H
 
 #include <bf_rt/bf_rt.hpp>
 #include <bf_rt/bf_rt_info.hpp>
@@ -13,10 +13,12 @@
 #include <bf_rt/bf_rt_table_key.hpp>
 #include <bf_rt/bf_rt_table_operations.hpp>
 
+#include "MulticastGroup.h"
+
 using namespace std;
 using namespace bfrt;
 
-class MulticastGroup{
+class BfRtMulticastGroup : public MulticastGroup {
     private:
         bf_status_t bf_status;
         // keep session, dev_tgt since we need it in many funcs
@@ -32,9 +34,9 @@ class MulticastGroup{
         bf_rt_id_t mgid;
         bf_rt_id_t mcast_node_id, mcast_node_xid_valid, mcast_node_xid;
     public:
-        MulticastGroup(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
+        BfRtMulticastGroup(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
 
         void add_group(uint16_t group_id, vector<uint16_t> rids);
 };
 
-#endif // MULTICASTGROUP_H
\ No newline at end of file
+#endif // BFRTMULTICASTGROUP_H
\ No newline at end of file
@@ -1,6 +1,6 @@
-#include "Node.h"
+#include "BfRtNode.h"
 
-Node::Node(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info) {
+BfRtNode::BfRtNode(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info) {
     this->session = session;
     this->dev_tgt = dev_tgt;
 
@@ -23,7 +23,7 @@ Node::Node(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtIn
     bf_sys_assert(bf_status == BF_SUCCESS);
 }
 
-void Node::add_node(uint16_t rid, uint16_t port) {
+void BfRtNode::add_node(uint16_t rid, uint16_t port) {
     // reset
     bf_status = node->keyReset(_key.get());
     bf_sys_assert(bf_status == BF_SUCCESS);
@@ -1,6 +1,6 @@
-#ifndef NODE_H // Include guards to prevent multiple inclusion
+#ifndef BFRTNODE_H // Include guards to prevent multiple inclusion
 
-#define NODE_H
+#define BFRTNODE_H
 
 #include <bf_rt/bf_rt.hpp>
 #include <bf_rt/bf_rt_info.hpp>
@@ -13,10 +13,12 @@
 #include <bf_rt/bf_rt_table_key.hpp>
 #include <bf_rt/bf_rt_table_operations.hpp>
 
+#include "Node.h"
+
 using namespace std;
 using namespace bfrt;
 
-class Node {
+class BfRtNode : public Node {
     private:
         bf_status_t bf_status;
         // keep session, dev_tgt since we need it in many funcs
@@ -34,9 +36,9 @@ class Node {
         bf_rt_id_t multicast_rid, dev_port;
         bf_rt_id_t mcast_rid, mcast_grp_a, mcast_grp_a_valid, mcast_grp_b, mcast_grp_b_valid, max_pkt_len;
     public:
-        Node(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
+        BfRtNode(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
 
         void add_node(uint16_t rid, uint16_t port);
 };
 
-#endif // NODE_H
\ No newline at end of file
+#endif // BFRTNODE_H
\ No newline at end of file
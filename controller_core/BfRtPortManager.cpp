@@ -1,6 +1,6 @@
-#include "PortManager.h"
+#include "BfRtPortManager.h"
 
-PortManager::PortManager(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info){
+BfRtPortManager::BfRtPortManager(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info){
     this->session = session;
     this->dev_tgt = dev_tgt;
 
@@ -28,7 +28,7 @@ PortManager::PortManager(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt
 }
 
 // Enable port and set speed
-void PortManager::port_enable(const uint16_t &port, const string &speed) {
+void BfRtPortManager::port_enable(const uint16_t &port, const string &speed) {
     // reset
     bf_status = port_manager->keyReset(_key.get());
     bf_sys_assert(bf_status == BF_SUCCESS);
@@ -1,6 +1,6 @@
-#ifndef PORTMGR_H // Include guards to prevent multiple inclusion
+#ifndef BFRTPORTMGR_H // Include guards to prevent multiple inclusion
 
-#define PORTMGR_H
+#define BFRTPORTMGR_H
 
 #include <bf_rt/bf_rt.hpp>
 #include <bf_rt/bf_rt_info.hpp>
@@ -13,10 +13,12 @@
 #include <bf_rt/bf_rt_table_key.hpp>
 #include <bf_rt/bf_rt_table_operations.hpp>
 
+#include "PortManager.h"
+
 using namespace std;
 using namespace bfrt;
 
-class PortManager {
+class BfRtPortManager : public PortManager {
     private:
         bf_status_t bf_status;
         // keep session, dev_tgt since we need it in many funcs
@@ -33,9 +35,9 @@ class PortManager {
         bf_rt_id_t dev_port_id, speed_id, fec_id, port_enable_id, auto_neg_id;
         bf_rt_id_t register_index_id, register_value_id;
     public:
-        PortManager(shared_ptr<BfRtSession> sess, bf_rt_target_t tgt, const BfRtInfo *bf_rt_info);
+        BfRtPortManager(shared_ptr<BfRtSession> sess, bf_rt_target_t tgt, const BfRtInfo *bf_rt_info);
 
         void port_enable(const uint16_t &port, const string &speed);
 };
 
-#endif // PORTMGR_H
\ No newline at end of file
+#endif // BFRTPORTMGR_H
\ No newline at end of file
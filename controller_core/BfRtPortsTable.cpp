@@ -1,6 +1,6 @@
-#include "PortsTable.h"
+#include "BfRtPortsTable.h"
 
-PortsTable::PortsTable(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info){
+BfRtPortsTable::BfRtPortsTable(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info){
     this->session = session;
     this->dev_tgt = dev_tgt;
 
@@ -31,7 +31,7 @@ PortsTable::PortsTable(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt,
     bf_sys_assert(bf_status == BF_SUCCESS);
 }
 
-void PortsTable::add_entry(const uint16_t &port, bool direction){
+void BfRtPortsTable::add_entry(const uint16_t &port, bool direction){
     // reset
     bf_status = ports_table->keyReset(_key.get());
     bf_sys_assert(bf_status == BF_SUCCESS);
@@ -1,6 +1,6 @@
-#ifndef PORTSTABLE_H // Include guards to prevent multiple inclusion
+#ifndef BFRTPORTSTABLE_H // Include guards to prevent multiple inclusion
 
-#define PORTSTABLE_H
+#define BFRTPORTSTABLE_H
 
 #include <bf_rt/bf_rt.hpp>
 #include <bf_rt/bf_rt_info.hpp>
@@ -13,10 +13,12 @@
 #include <bf_rt/bf_rt_table_key.hpp>
 #include <bf_rt/bf_rt_table_operations.hpp>
 
+#include "PortsTable.h"
+
 using namespace std;
 using namespace bfrt;
 
-class PortsTable{
+class BfRtPortsTable : public PortsTable {
     private:
         bf_status_t bf_status;
         // keep session, dev_tgt since we need it in many funcs
@@ -33,9 +35,9 @@ class PortsTable{
         bf_rt_id_t incoming_action_id, outgoing_action_id;
         bf_rt_id_t ingress_port_id;
     public:
-        PortsTable(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
+        BfRtPortsTable(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
 
         void add_entry(const uint16_t &port, bool direction);
 };
 
-#endif // PORTSTABLE_H
\ No newline at end of file
+#endif // BFRTPORTSTABLE_H
\ No newline at end of file
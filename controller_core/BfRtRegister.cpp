@@ -0,0 +1,212 @@
+#include "BfRtRegister.h"
+
+BfRtRegister::BfRtRegister(const string &name, shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info)
+        : _flag(BfRtTable::BfRtTableGetFlag::GET_FROM_SW), op_type(TableOperationsType::REGISTER_SYNC) {
+            this->session = session;
+            this->dev_tgt = dev_tgt;
+            
+            // get the register table
+            bf_status = bf_rt_info->bfrtTableFromNameGet(name, &register_table);
+            bf_sys_assert(bf_status == BF_SUCCESS);
+            
+            // confirm it is a register
+            BfRtTable::TableType table_type;
+            bf_status = register_table->tableTypeGet(&table_type);
+            bf_sys_assert(bf_status == BF_SUCCESS);
+            bf_sys_assert(table_type == BfRtTable::TableType::REGISTER);
+            
+            // allocate register operations
+            bf_status = register_table->operationsAllocate(op_type, &table_ops);
+            bf_sys_assert(bf_status == BF_SUCCESS);
+            bf_status = table_ops->registerSyncSet(*session, dev_tgt, BfRtRegister::sync_callback, &cookie);
+            bf_sys_assert(bf_status == BF_SUCCESS);
+            
+            // get key/data IDs
+            bf_status = register_table->keyFieldIdGet("$REGISTER_INDEX", &_register_index_id);
+            bf_sys_assert(bf_status == BF_SUCCESS);
+            string data_field_name = name.substr(name.find_first_of(".") + 1) + ".f1";
+            bf_status = register_table->dataFieldIdGet(data_field_name, &_f1_id);
+            bf_sys_assert(bf_status == BF_SUCCESS);
+
+            // allocate key and data
+            bf_status = register_table->keyAllocate(&_key);
+            bf_sys_assert(bf_status == BF_SUCCESS); 
+            bf_status = register_table->dataAllocate(&_data);
+            bf_sys_assert(bf_status == BF_SUCCESS);
+        }
+
+// Sync callback function
+void BfRtRegister::sync_callback(const bf_rt_target_t &, void *cookie) {
+    struct RegisterSync* local_cookie = (struct RegisterSync*) cookie;
+
+    unique_lock<mutex> lck(local_cookie->register_sync_lock);
+    local_cookie->register_sync_completed.notify_all();
+}
+
+// start syncing the register
+unique_lock<mutex> BfRtRegister::start_sync() {
+    unique_lock<mutex> lck(cookie.register_sync_lock);
+
+    // execute sync operations
+    bf_status = register_table->tableOperationsExecute(*table_ops);
+    bf_sys_assert(bf_status == BF_SUCCESS);
+
+    return lck;
+}
+
+// wait for syncing to complete
+void BfRtRegister::end_sync(unique_lock<mutex> &lck) {
+    cookie.register_sync_completed.wait(lck);
+    lck.unlock();
+}
+
+vector<vector<uint64_t>> BfRtRegister::get_entries(const uint32_t start_idx,
+                                    const uint32_t end_idx) {
+    vector<vector<uint64_t>> output;
+    output.reserve(end_idx - start_idx);
+
+    for(uint32_t index = start_idx; index < end_idx + 1; index++){
+        // reset
+        bf_status = register_table->keyReset(_key.get());
+        bf_sys_assert(bf_status == BF_SUCCESS);
+        bf_status = register_table->dataReset(_data.get());
+        bf_sys_assert(bf_status == BF_SUCCESS);
+
+        // set value
+        bf_status = _key->setValue(_register_index_id, index);
+        bf_sys_assert(bf_status == BF_SUCCESS);
+        
+        bf_status = register_table->tableEntryGet(*session, dev_tgt, *_key, _flag, _data.get());
+        bf_sys_assert(bf_status == BF_SUCCESS);
+        
+        vector<uint64_t> temp_val;
+        bf_status = _data->getValue(_f1_id, &temp_val);
+        bf_sys_assert(bf_status == BF_SUCCESS);
+        output.push_back(temp_val);
+    }
+    
+    return output;
+}
+
+// OR-reduce the per-pipe values of one entry into its bit
+void BfRtRegister::set_bitmap_bit(vector<uint64_t> &bitmap, const uint32_t start_idx, const BfRtTableKey &key,
+                                const BfRtTableData &data) {
+    uint64_t index;
+    bf_status = key.getValue(_register_index_id, &index);
+    bf_sys_assert(bf_status == BF_SUCCESS);
+    bf_status = data.getValue(_f1_id, &_pipe_values);
+    bf_sys_assert(bf_status == BF_SUCCESS);
+
+    // entries outside the range have no bit; this also catches index < start_idx
+    uint64_t offset = index - start_idx;
+    if(offset / 64 >= bitmap.size()){
+        return;
+    }
+
+    for(auto value: _pipe_values){
+        if(value != 0){
+            bitmap[offset / 64] |= 1ULL << (offset % 64);
+            break;
+        }
+    }
+}
+
+// read the whole range in batches of REGISTER_READ_BATCH entries;
+// bit (index - start_idx) is set if the entry is non-zero in any pipe
+void BfRtRegister::get_entries_bitmap(const uint32_t start_idx, const uint32_t end_idx,
+                                    vector<uint64_t> &bitmap) {
+    uint32_t total = end_idx - start_idx + 1;
+    // empty range (end_idx == start_idx - 1): nothing to read
+    if(end_idx < start_idx || total == 0){
+        bitmap.clear();
+        return;
+    }
+    bitmap.assign((total + 63) / 64, 0);
+
+    if(_batch_keys.empty()){
+        _batch_keys.resize(REGISTER_READ_BATCH);
+        _batch_data.resize(REGISTER_READ_BATCH);
+        for(uint32_t j = 0; j < REGISTER_READ_BATCH; j++){
+            bf_status = register_table->keyAllocate(&_batch_keys[j]);
+            bf_sys_assert(bf_status == BF_SUCCESS);
+            bf_status = register_table->dataAllocate(&_batch_data[j]);
+            bf_sys_assert(bf_status == BF_SUCCESS);
+        }
+    }
+
+    // fetch the first entry, the batches continue from its key
+    bf_status = register_table->keyReset(_key.get());
+    bf_sys_assert(bf_status == BF_SUCCESS);
+    bf_status = register_table->dataReset(_data.get());
+    bf_sys_assert(bf_status == BF_SUCCESS);
+
+    if(start_idx == 0){
+        bf_status = register_table->tableEntryGetFirst(*session, dev_tgt, _flag, _key.get(), _data.get());
+        bf_sys_assert(bf_status == BF_SUCCESS);
+    }
+    else{
+        bf_status = _key->setValue(_register_index_id, start_idx);
+        bf_sys_assert(bf_status == BF_SUCCESS);
+        bf_status = register_table->tableEntryGet(*session, dev_tgt, *_key, _flag, _data.get());
+        bf_sys_assert(bf_status == BF_SUCCESS);
+    }
+    set_bitmap_bit(bitmap, start_idx, *_key, *_data);
+
+    uint32_t remaining = total - 1;
+    while(remaining > 0){
+        uint32_t n = min(remaining, (uint32_t) REGISTER_READ_BATCH);
+        uint32_t num_returned = 0;
+
+        _batch_pairs.clear();
+        for(uint32_t j = 0; j < n; j++){
+            _batch_pairs.emplace_back(_batch_keys[j].get(), _batch_data[j].get());
+        }
+
+        bf_status = register_table->tableEntryGetNext_n(*session, dev_tgt, *_key, n, _flag,
+                                                        &_batch_pairs, &num_returned);
+        bf_sys_assert(bf_status == BF_SUCCESS);
+        if(num_returned == 0){
+            break;
+        }
+
+        for(uint32_t j = 0; j < num_returned; j++){
+            set_bitmap_bit(bitmap, start_idx, *_batch_pairs[j].first, *_batch_pairs[j].second);
+        }
+
+        // continue after the last returned index
+        uint64_t last_idx;
+        bf_status = _batch_pairs[num_returned - 1].first->getValue(_register_index_id, &last_idx);
+        bf_sys_assert(bf_status == BF_SUCCESS);
+        bf_status = _key->setValue(_register_index_id, last_idx);
+        bf_sys_assert(bf_status == BF_SUCCESS);
+
+        remaining -= num_returned;
+    }
+}
+
+void BfRtRegister::add_entries(vector<uint32_t> keys, int value){
+    // begin batch
+    bf_status = session->beginBatch();
+    bf_sys_assert(bf_status == BF_SUCCESS);
+
+    for(auto index: keys){
+        // reset key and data
+        bf_status = register_table->keyReset(_key.get());
+        bf_sys_assert(bf_status == BF_SUCCESS);
+        bf_status = register_table->dataReset(_data.get());
+        bf_sys_assert(bf_status == BF_SUCCESS);
+        
+        bf_status = _key->setValue(_register_index_id, index);
+        bf_sys_assert(bf_status == BF_SUCCESS);
+        bf_status = _data->setValue(_f1_id, (uint64_t) value);
+        bf_sys_assert(bf_status == BF_SUCCESS);
+
+        bf_status = register_table->tableEntryAdd(*session, dev_tgt, *_key, *_data);
+        bf_sys_assert(bf_status == BF_SUCCESS);
+    }
+
+    // end batch
+    bf_status = session->endBatch(true);
+    bf_sys_assert(bf_status == BF_SUCCESS);
+}
+
@@ -1,6 +1,6 @@
-#ifndef REGISTER_H // Include guards to prevent multiple inclusion
+#ifndef BFRTREGISTER_H // Include guards to prevent multiple inclusion
 
-#define REGISTER_H
+#define BFRTREGISTER_H
 
 #include <mutex>
 #include <condition_variable>
@@ -16,6 +16,8 @@
 #include <bf_rt/bf_rt_table_key.hpp>
 #include <bf_rt/bf_rt_table_operations.hpp>
 
+#include "Register.h"
+
 using namespace std;
 using namespace bfrt;
 
@@ -26,7 +28,7 @@ struct RegisterSync {
     condition_variable register_sync_completed;
 };
 
-class Register {
+class BfRtRegister : public Register {
     private:
         bf_status_t bf_status;
         // keep session, dev_tgt since we need it in many funcs
@@ -47,11 +49,22 @@ class Register {
         unique_ptr<BfRtTableData> _data;
         bf_rt_id_t _register_index_id, _register_value_id;
         bf_rt_id_t _f1_id;
+
+        // for bulk reads, allocated on first use
+        vector<unique_ptr<BfRtTableKey>> _batch_keys;
+        vector<unique_ptr<BfRtTableData>> _batch_data;
+        BfRtTable::keyDataPairs _batch_pairs;
+        vector<uint64_t> _pipe_values;
+
+        void set_bitmap_bit(vector<uint64_t> &bitmap, const uint32_t start_idx, const BfRtTableKey &key,
+                            const BfRtTableData &data);
     public:
-        Register(const string &name, shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
+        BfRtRegister(const string &name, shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
 
         vector<vector<uint64_t>> get_entries(const uint32_t start_idx, const uint32_t end_idx);
 
+        void get_entries_bitmap(const uint32_t start_idx, const uint32_t end_idx, vector<uint64_t> &bitmap);
+
         void add_entries(vector<uint32_t> keys, int value);
 
         static void sync_callback(const bf_rt_target_t &, void *cookie);
@@ -0,0 +1,150 @@
+#include "Checkpoint.h"
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <iostream>
+
+Checkpoint::Checkpoint(const string &path, uint32_t every, uint16_t banks, uint16_t alpha, uint32_t interval){
+    this->path = path;
+    this->every = every;
+    this->banks = banks;
+    this->alpha = alpha;
+    this->interval = interval;
+
+    fd = -1;
+    data = nullptr;
+    size = 0;
+}
+
+bool Checkpoint::enabled(){
+    return !path.empty();
+}
+
+bool Checkpoint::due(uint64_t epoch){
+    return enabled() && every != 0 && epoch % every == 0;
+}
+
+uint16_t *Checkpoint::begin(uint64_t epoch, const vector<PrefixMapRecord> &records, uint64_t addr_count){
+    string tmp_path = path + ".tmp";
+    size_t records_size = records.size() * sizeof(PrefixMapRecord);
+    size = sizeof(CheckpointHeader) + records_size + addr_count * sizeof(uint16_t);
+
+    fd = open(tmp_path.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if(fd < 0 || ftruncate(fd, size) != 0){
+        cerr << "Error: Could not create checkpoint " << tmp_path << ": " << strerror(errno) << endl;
+        if(fd >= 0){
+            close(fd);
+            remove(tmp_path.c_str());
+        }
+        fd = -1;
+        return nullptr;
+    }
+    data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(data == MAP_FAILED){
+        cerr << "Error: Could not map checkpoint " << tmp_path << ": " << strerror(errno) << endl;
+        close(fd);
+        remove(tmp_path.c_str());
+        fd = -1;
+        data = nullptr;
+        return nullptr;
+    }
+
+    CheckpointHeader *header = (CheckpointHeader *) data;
+    memcpy(header->magic, CHECKPOINT_MAGIC, sizeof(header->magic));
+    header->version = CHECKPOINT_VERSION;
+    header->banks = banks;
+    header->alpha = alpha;
+    header->reserved = 0;
+    header->interval = interval;
+    header->epoch = epoch;
+    header->saved_at = time(nullptr);
+    header->record_count = records.size();
+    header->record_size = sizeof(PrefixMapRecord);
+    header->addr_count = addr_count;
+    memcpy(header + 1, records.data(), records_size);
+
+    return (uint16_t *) ((uint8_t *) data + sizeof(CheckpointHeader) + records_size);
+}
+
+bool Checkpoint::commit(){
+    string tmp_path = path + ".tmp";
+    bool ok = msync(data, size, MS_SYNC) == 0;
+    ok = munmap(data, size) == 0 && ok;
+    ok = fsync(fd) == 0 && ok;
+    ok = close(fd) == 0 && ok;
+    fd = -1;
+    data = nullptr;
+
+    if(!ok || rename(tmp_path.c_str(), path.c_str()) != 0){
+        cerr << "Error: Could not write checkpoint " << path << ": " << strerror(errno) << endl;
+        remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool Checkpoint::load(const vector<PrefixMapRecord> &records, uint64_t addr_count,
+                        vector<uint16_t> &counters, uint64_t &epoch){
+    if(!enabled()){
+        return false;
+    }
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0){
+        cout << "No checkpoint at " << path << ", starting cold" << endl;
+        return false;
+    }
+    struct stat st;
+    if(fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(CheckpointHeader)){
+        cout << "Ignoring checkpoint " << path << ": truncated" << endl;
+        close(fd);
+        return false;
+    }
+    void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(data == MAP_FAILED){
+        cerr << "Error: Could not map checkpoint " << path << ": " << strerror(errno) << endl;
+        return false;
+    }
+
+    const CheckpointHeader *header = (const CheckpointHeader *) data;
+    size_t records_size = records.size() * sizeof(PrefixMapRecord);
+    string error;
+    if(memcmp(header->magic, CHECKPOINT_MAGIC, sizeof(header->magic)) != 0 || header->version != CHECKPOINT_VERSION){
+        error = "not a version " + to_string(CHECKPOINT_VERSION) + " checkpoint";
+    }
+    else if(header->banks != banks || header->alpha != alpha){
+        error = "written with " + to_string(header->banks) + " banks and alpha " + to_string(header->alpha);
+    }
+    else if(header->record_size != sizeof(PrefixMapRecord) || header->record_count != records.size() ||
+            header->addr_count != addr_count ||
+            (size_t) st.st_size != sizeof(CheckpointHeader) + records_size + addr_count * sizeof(uint16_t) ||
+            memcmp(header + 1, records.data(), records_size) != 0){
+        error = "written for other monitored prefixes";
+    }
+
+    if(error.empty()){
+        // no epoch ran while the controller was down, so no counter was reset either
+        uint64_t now = time(nullptr);
+        uint64_t missed = header->interval && now > header->saved_at ? (now - header->saved_at) / header->interval : 0;
+        const uint16_t *saved = (const uint16_t *) ((const uint8_t *) data + sizeof(CheckpointHeader) + records_size);
+
+        counters.resize(addr_count);
+        for(uint64_t i = 0; i < addr_count; i++){
+            counters[i] = saved[i] > missed ? saved[i] - missed : 0;
+        }
+        epoch = header->epoch;
+        cout << "Restored checkpoint " << path << " of epoch " << epoch << ", " << missed << " epochs missed" << endl;
+    }
+    else{
+        cout << "Ignoring checkpoint " << path << ": " << error << endl;
+    }
+
+    munmap(data, st.st_size);
+    return error.empty();
+}
@@ -0,0 +1,77 @@
+#ifndef CHECKPOINT_H // Include guards to prevent multiple inclusion
+
+#define CHECKPOINT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include "PrefixMap.h"
+
+#define CHECKPOINT_MAGIC "TCKP"
+#define CHECKPOINT_VERSION 1
+
+using namespace std;
+
+// start of the file
+struct CheckpointHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t banks;
+    uint16_t alpha;
+    uint16_t reserved;
+    uint32_t interval;          // seconds between two epochs
+    uint64_t epoch;             // epochs run when it was written
+    uint64_t saved_at;          // UTC seconds
+    uint32_t record_count;      // prefix map records after the header
+    uint32_t record_size;
+    uint64_t addr_count;        // counters after the records
+};
+
+/*
+ * Aging state of every monitored address, persisted so that a restarted
+ * controller resumes where the previous one stopped instead of waiting
+ * alpha epochs before it declares anything dark.
+ *
+ * The file holds the header, the prefix map of the controller that wrote
+ * it and one counter per address index (BANKS * i + t for register index
+ * i of bank t) in the epoch_update() convention: 0 once inactive,
+ * otherwise the epochs left before it expires. begin() maps a temporary
+ * file for the counters and commit() syncs it and renames it over path,
+ * so a crash while writing leaves the previous checkpoint in place.
+ */
+class Checkpoint {
+    private:
+        string path;
+        uint32_t every;
+        uint16_t banks;
+        uint16_t alpha;
+        uint32_t interval;
+
+        // checkpoint being written
+        int fd;
+        void *data;
+        size_t size;
+    public:
+        // an empty path disables checkpoints; one is written every `every` epochs
+        Checkpoint(const string &path, uint32_t every, uint16_t banks, uint16_t alpha, uint32_t interval);
+
+        bool enabled();
+
+        // whether a checkpoint is written after epoch
+        bool due(uint64_t epoch);
+
+        // maps a new checkpoint and returns its addr_count counters to fill in, nullptr on failure
+        uint16_t *begin(uint64_t epoch, const vector<PrefixMapRecord> &records, uint64_t addr_count);
+
+        // makes the checkpoint filled in since begin() the current one; false on failure
+        bool commit();
+
+        // reads the checkpoint at path if it was written for the same prefixes, banks and alpha;
+        // the counters are aged by the epochs missed since it was written
+        bool load(const vector<PrefixMapRecord> &records, uint64_t addr_count,
+                    vector<uint16_t> &counters, uint64_t &epoch);
+};
+
+#endif // CHECKPOINT_H
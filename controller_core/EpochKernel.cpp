@@ -0,0 +1,194 @@
+#include "EpochKernel.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+void BankUpdate::clear(){
+    global_indices.clear();
+    flag_indices.clear();
+    inactive_indices.clear();
+    hold_indices.clear();
+    cur_active_addr_cnt = 0;
+    active_addr_cnt = 0;
+    inactive_addr = 0;
+}
+
+void BankUpdate::offset(uint32_t base){
+    if(base == 0){
+        return;
+    }
+    for(auto &i: global_indices){
+        i += base;
+    }
+    for(auto &i: flag_indices){
+        i += base;
+    }
+    for(auto &i: inactive_indices){
+        i += base;
+    }
+    for(auto &i: hold_indices){
+        i += base;
+    }
+}
+
+// push base + position of every set bit
+static inline void push_bits(vector<uint32_t> &indices, uint64_t mask, uint32_t base){
+    while(mask){
+        indices.push_back(base + __builtin_ctzll(mask));
+        mask &= mask - 1;
+    }
+}
+
+// turn the masks of one word into index lists and counts;
+// zero/one are the counters that were 0/1 before the update
+static inline void account_word(uint32_t base, uint64_t valid, uint64_t active, uint64_t zero, uint64_t one,
+                                uint32_t meter_shift, uint32_t *inactive_pfxs, BankUpdate &out){
+    uint64_t inactive = ~active & (zero | one) & valid;
+
+    push_bits(out.global_indices, active & zero, base);
+    push_bits(out.flag_indices, active, base);
+    push_bits(out.inactive_indices, ~active & one & valid, base);
+    if(out.collect_hold){
+        push_bits(out.hold_indices, ~active & ~(zero | one) & valid, base);
+    }
+
+    out.cur_active_addr_cnt += __builtin_popcountll(active);
+    out.active_addr_cnt += __builtin_popcountll(valid & ~inactive);
+    out.inactive_addr += __builtin_popcountll(inactive);
+
+    if(inactive_pfxs != nullptr && inactive != 0){
+        if(meter_shift >= 6){
+            // the whole word falls in one meter
+            inactive_pfxs[base >> meter_shift] += __builtin_popcountll(inactive);
+        }
+        else{
+            while(inactive){
+                inactive_pfxs[(base + __builtin_ctzll(inactive)) >> meter_shift]++;
+                inactive &= inactive - 1;
+            }
+        }
+    }
+}
+
+// indices [64 * first_word, n)
+static void update_words_scalar(const uint64_t *flags, uint16_t *counters, uint32_t first_word, uint32_t n,
+                                uint16_t alpha, uint32_t meter_shift, uint32_t *inactive_pfxs, BankUpdate &out){
+    uint16_t reset = alpha + 1;
+
+    for(uint32_t base = first_word * 64; base < n; base += 64){
+        uint32_t len = min(n - base, (uint32_t) 64);
+        uint64_t valid = (len == 64) ? ~0ULL : (1ULL << len) - 1;
+        uint64_t active = flags[base / 64] & valid;
+        uint64_t zero = 0, one = 0;
+
+        for(uint32_t j = 0; j < len; j++){
+            uint16_t c = counters[base + j];
+            zero |= (uint64_t) (c == 0) << j;
+            one |= (uint64_t) (c == 1) << j;
+
+            if((active >> j) & 1){
+                counters[base + j] = reset;
+            }
+            else{
+                counters[base + j] = (c > 1) ? c - 1 : 0;
+            }
+        }
+        account_word(base, valid, active, zero, one, meter_shift, inactive_pfxs, out);
+    }
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2")))
+static void update_words_avx2(const uint64_t *flags, uint16_t *counters, uint32_t words, uint16_t alpha,
+                                uint32_t meter_shift, uint32_t *inactive_pfxs, BankUpdate &out){
+    const __m256i bit_select = _mm256_setr_epi16(0x0001, 0x0002, 0x0004, 0x0008, 0x0010, 0x0020, 0x0040, 0x0080,
+                                                 0x0100, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x4000,
+                                                 (short) 0x8000);
+    const __m256i zero_v = _mm256_setzero_si256();
+    const __m256i one_v = _mm256_set1_epi16(1);
+    const __m256i reset_v = _mm256_set1_epi16((short) (uint16_t) (alpha + 1));
+
+    for(uint32_t w = 0; w < words; w++){
+        uint64_t active = flags[w];
+        uint64_t zero = 0, one = 0;
+        uint16_t *c = counters + 64 * w;
+
+        for(int q = 0; q < 4; q++){
+            __m256i v = _mm256_loadu_si256((const __m256i *) (c + 16 * q));
+            // expand 16 flag bits to 16 lanes
+            __m256i a = _mm256_set1_epi16((short) (uint16_t) (active >> (16 * q)));
+            a = _mm256_cmpeq_epi16(_mm256_and_si256(a, bit_select), bit_select);
+
+            __m256i is_zero = _mm256_cmpeq_epi16(v, zero_v);
+            __m256i is_one = _mm256_cmpeq_epi16(v, one_v);
+            __m256i dec = _mm256_andnot_si256(_mm256_or_si256(is_zero, is_one), _mm256_sub_epi16(v, one_v));
+            _mm256_storeu_si256((__m256i *) (c + 16 * q), _mm256_blendv_epi8(dec, reset_v, a));
+
+            // pack both masks to bytes: low 16 bits are zero, high 16 bits are one
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(is_zero, is_one), 0xD8);
+            uint32_t bits = (uint32_t) _mm256_movemask_epi8(packed);
+            zero |= (uint64_t) (bits & 0xFFFF) << (16 * q);
+            one |= (uint64_t) (bits >> 16) << (16 * q);
+        }
+        account_word(64 * w, ~0ULL, active, zero, one, meter_shift, inactive_pfxs, out);
+    }
+}
+
+__attribute__((target("avx512bw")))
+static void update_words_avx512(const uint64_t *flags, uint16_t *counters, uint32_t words, uint16_t alpha,
+                                uint32_t meter_shift, uint32_t *inactive_pfxs, BankUpdate &out){
+    const __m512i zero_v = _mm512_setzero_si512();
+    const __m512i one_v = _mm512_set1_epi16(1);
+    const __m512i reset_v = _mm512_set1_epi16((short) (uint16_t) (alpha + 1));
+
+    for(uint32_t w = 0; w < words; w++){
+        uint64_t active = flags[w];
+        uint64_t zero = 0, one = 0;
+        uint16_t *c = counters + 64 * w;
+
+        for(int h = 0; h < 2; h++){
+            __m512i v = _mm512_loadu_si512((const void *) (c + 32 * h));
+            __mmask32 a = (__mmask32) (active >> (32 * h));
+            __mmask32 is_zero = _mm512_cmpeq_epi16_mask(v, zero_v);
+            __mmask32 is_one = _mm512_cmpeq_epi16_mask(v, one_v);
+            __m512i dec = _mm512_maskz_sub_epi16(~(is_zero | is_one), v, one_v);
+            _mm512_storeu_si512((void *) (c + 32 * h), _mm512_mask_blend_epi16(a, dec, reset_v));
+
+            zero |= (uint64_t) is_zero << (32 * h);
+            one |= (uint64_t) is_one << (32 * h);
+        }
+        account_word(64 * w, ~0ULL, active, zero, one, meter_shift, inactive_pfxs, out);
+    }
+}
+#endif
+
+void epoch_update_scalar(const uint64_t *flags, uint16_t *counters, uint32_t n, uint16_t alpha,
+                            uint32_t meter_shift, uint32_t *inactive_pfxs, BankUpdate &out){
+    update_words_scalar(flags, counters, 0, n, alpha, meter_shift, inactive_pfxs, out);
+}
+
+void epoch_update(const uint64_t *flags, uint16_t *counters, uint32_t n, uint16_t alpha,
+                    uint32_t meter_shift, uint32_t *inactive_pfxs, BankUpdate &out){
+    uint32_t words = n / 64;
+
+#if defined(__x86_64__)
+    static const bool has_avx512 = __builtin_cpu_supports("avx512bw");
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+
+    if(has_avx512){
+        update_words_avx512(flags, counters, words, alpha, meter_shift, inactive_pfxs, out);
+    }
+    else if(has_avx2){
+        update_words_avx2(flags, counters, words, alpha, meter_shift, inactive_pfxs, out);
+    }
+    else{
+        words = 0;
+    }
+#else
+    words = 0;
+#endif
+
+    // remaining partial word (or everything without SIMD)
+    update_words_scalar(flags, counters, words, n, alpha, meter_shift, inactive_pfxs, out);
+}
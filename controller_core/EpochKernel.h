@@ -0,0 +1,48 @@
+#ifndef EPOCHKERNEL_H // Include guards to prevent multiple inclusion
+
+#define EPOCHKERNEL_H
+
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+// result of classifying one register bank for one epoch;
+// all indices are register (bank-local) indices
+struct BankUpdate {
+    vector<uint32_t> global_indices;    // were inactive, now flagged: set global to 1
+    vector<uint32_t> flag_indices;      // flagged in this epoch: reset flag to 0
+    vector<uint32_t> inactive_indices;  // counter expired in this epoch: set global to 0
+    vector<uint32_t> hold_indices;      // not flagged, counter still running; only if collect_hold
+    bool collect_hold = false;          // kept by clear(), set for EVENT_LEVEL_ALL
+    uint32_t cur_active_addr_cnt;       // flagged in this epoch
+    uint32_t active_addr_cnt;           // flagged or counter still running
+    uint32_t inactive_addr;             // not flagged and counter expired
+
+    void clear();
+
+    // add base to every index, for banks processed in shards
+    void offset(uint32_t base);
+};
+
+/*
+ * Update the activity counters of one bank from its flag bitmap.
+ *
+ * flags holds one bit per register index and counters one entry per
+ * register index of the bank. A flagged index gets its counter set to
+ * alpha + 1, otherwise a counter above 1 is decremented and a counter of
+ * 1 expires to 0. If inactive_pfxs is not null, every inactive index i
+ * increments inactive_pfxs[i >> meter_shift].
+ *
+ * 64 indices are processed per flag word, with AVX-512BW or AVX2 when the
+ * CPU supports them and a scalar loop otherwise.
+ */
+void epoch_update(const uint64_t *flags, uint16_t *counters, uint32_t n, uint16_t alpha,
+                    uint32_t meter_shift, uint32_t *inactive_pfxs, BankUpdate &out);
+
+// same as epoch_update, without SIMD; used for the tail and as reference
+void epoch_update_scalar(const uint64_t *flags, uint16_t *counters, uint32_t n, uint16_t alpha,
+                            uint32_t meter_shift, uint32_t *inactive_pfxs, BankUpdate &out);
+
+#endif // EPOCHKERNEL_H
@@ -0,0 +1,140 @@
+#include "EventLog.h"
+
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <chrono>
+#include <iostream>
+
+EventLog::EventLog(const string &path, EventLevel level, uint64_t max_bytes){
+    this->path = path;
+    this->level = path.empty() ? EVENT_LEVEL_OFF : level;
+    this->max_bytes = max_bytes;
+
+    ring = nullptr;
+    head = 0;
+    tail = 0;
+    file = nullptr;
+    file_bytes = 0;
+    epoch = 0;
+
+    if(this->level == EVENT_LEVEL_OFF){
+        return;
+    }
+
+    // slot i is free for the record with sequence number i
+    ring = new Slot[EVENT_LOG_CAPACITY];
+    for(uint64_t i = 0; i < EVENT_LOG_CAPACITY; i++){
+        ring[i].seq.store(i, memory_order_relaxed);
+    }
+
+    open_file();
+    writer = thread(&EventLog::drain, this);
+    writer.detach();
+}
+
+bool EventLog::parse_level(const string &name, EventLevel &level){
+    if(name == "off"){
+        level = EVENT_LEVEL_OFF;
+    }
+    else if(name == "transitions"){
+        level = EVENT_LEVEL_TRANSITIONS;
+    }
+    else if(name == "flags"){
+        level = EVENT_LEVEL_FLAGS;
+    }
+    else if(name == "all"){
+        level = EVENT_LEVEL_ALL;
+    }
+    else{
+        return false;
+    }
+    return true;
+}
+
+int EventLog::required_level(uint16_t type){
+    switch(type){
+        case EVENT_EPOCH:
+        case EVENT_ACTIVATED:
+        case EVENT_EXPIRED:
+            return EVENT_LEVEL_TRANSITIONS;
+        case EVENT_FLAG:
+            return EVENT_LEVEL_FLAGS;
+        default:
+            return EVENT_LEVEL_ALL;
+    }
+}
+
+bool EventLog::enabled(uint16_t type){
+    return level != EVENT_LEVEL_OFF && required_level(type) <= level;
+}
+
+void EventLog::open_file(){
+    file = fopen(path.c_str(), "wb");
+    if(file == nullptr){
+        cerr << "Error: Could not open event log " << path << ": " << strerror(errno) << endl;
+        exit(1);
+    }
+
+    EventLogHeader header;
+    memcpy(header.magic, EVENT_LOG_MAGIC, sizeof(header.magic));
+    header.version = EVENT_LOG_VERSION;
+    header.record_size = sizeof(EventRecord);
+    fwrite(&header, sizeof(header), 1, file);
+    file_bytes = sizeof(header);
+}
+
+void EventLog::rotate(){
+    fclose(file);
+    for(int i = EVENT_LOG_FILES - 1; i > 0; i--){
+        rename((path + "." + to_string(i)).c_str(), (path + "." + to_string(i + 1)).c_str());
+    }
+    rename(path.c_str(), (path + ".1").c_str());
+    open_file();
+}
+
+void EventLog::drain(){
+    vector<EventRecord> batch;
+    batch.reserve(4096);
+
+    while(true){
+        Slot *slot = &ring[tail & (EVENT_LOG_CAPACITY - 1)];
+
+        if(slot->seq.load(memory_order_acquire) == tail + 1){
+            batch.push_back(slot->record);
+            // free the slot for the record one lap ahead
+            slot->seq.store(tail + EVENT_LOG_CAPACITY, memory_order_release);
+            tail++;
+            if(batch.size() < batch.capacity()){
+                continue;
+            }
+        }
+
+        if(!batch.empty()){
+            fwrite(batch.data(), sizeof(EventRecord), batch.size(), file);
+            file_bytes += batch.size() * sizeof(EventRecord);
+            batch.clear();
+            if(max_bytes != 0 && file_bytes >= max_bytes){
+                rotate();
+            }
+        }
+        else{
+            // the ring is empty: make everything written so far visible and wait
+            fflush(file);
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+    }
+}
+
+void EventLog::start_epoch(){
+    if(level == EVENT_LEVEL_OFF){
+        return;
+    }
+    epoch++;
+    log(EVENT_EPOCH, vector<uint32_t>{(uint32_t) time(nullptr)});
+}
+
+void EventLog::resume(uint64_t epoch){
+    this->epoch = epoch;
+}
@@ -0,0 +1,125 @@
+#ifndef EVENTLOG_H // Include guards to prevent multiple inclusion
+
+#define EVENTLOG_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+
+// slots in the ring, a power of two
+#define EVENT_LOG_CAPACITY (1 << 20)
+// rotated files kept next to the current one: path.1 ... path.N
+#define EVENT_LOG_FILES 4
+#define EVENT_LOG_MAGIC "TLOG"
+#define EVENT_LOG_VERSION 1
+
+using namespace std;
+
+enum EventType : uint16_t {
+    EVENT_EPOCH = 0,        // start of an epoch; index holds the UTC time in seconds
+    EVENT_ACTIVATED = 1,    // was inactive, flagged in this epoch
+    EVENT_EXPIRED = 2,      // counter expired in this epoch
+    EVENT_FLAG = 3,         // flagged in this epoch
+    EVENT_HOLD = 4,         // not flagged, counter still running
+};
+
+// each level also logs the events of the levels below it
+enum EventLevel {
+    EVENT_LEVEL_OFF = 0,
+    EVENT_LEVEL_TRANSITIONS = 1,    // epochs, activated and expired addresses
+    EVENT_LEVEL_FLAGS = 2,          // + flagged addresses
+    EVENT_LEVEL_ALL = 3,            // + addresses kept active by their counter
+};
+
+struct EventRecord {
+    uint32_t index;         // address index, as printed by the controller
+    uint16_t type;
+    uint16_t epoch;         // low bits of the epoch number
+};
+
+// start of every log file
+struct EventLogHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t record_size;
+};
+
+/*
+ * Binary log of address events.
+ *
+ * Producers reserve slots in a lock-free ring and never touch the file;
+ * a background thread drains the ring to path and rotates it once it
+ * grows past max_bytes. A producer only waits when the ring is full.
+ * The event_log_dump tool converts the files back to text.
+ */
+class EventLog {
+    private:
+        struct Slot {
+            atomic<uint64_t> seq;
+            EventRecord record;
+        };
+
+        Slot *ring;
+        atomic<uint64_t> head;
+        uint64_t tail;
+
+        EventLevel level;
+        string path;
+        uint64_t max_bytes;
+        FILE *file;
+        uint64_t file_bytes;
+        uint16_t epoch;
+        thread writer;
+
+        void open_file();
+
+        void rotate();
+
+        void drain();
+    public:
+        // an empty path or EVENT_LEVEL_OFF disables the log
+        EventLog(const string &path, EventLevel level, uint64_t max_bytes);
+
+        // "off", "transitions", "flags" or "all"; false for anything else
+        static bool parse_level(const string &name, EventLevel &level);
+
+        static int required_level(uint16_t type);
+
+        bool enabled(uint16_t type);
+
+        // marks the start of the next epoch; called between epochs, not concurrently with log()
+        void start_epoch();
+
+        // continues the epoch numbering of a restored controller, see Checkpoint.h
+        void resume(uint64_t epoch);
+
+        // logs STRIDE * i + offset for every i in indices; the stride is the bank count, known at compile time
+        template <uint32_t STRIDE = 1>
+        void log(uint16_t type, const vector<uint32_t> &indices, uint32_t offset = 0);
+};
+
+template <uint32_t STRIDE>
+void EventLog::log(uint16_t type, const vector<uint32_t> &indices, uint32_t offset){
+    if(!enabled(type) || indices.empty()){
+        return;
+    }
+
+    // one reservation for the whole batch, then fill the slots in order
+    uint64_t pos = head.fetch_add(indices.size(), memory_order_relaxed);
+    for(uint64_t k = 0; k < indices.size(); k++){
+        Slot *slot = &ring[(pos + k) & (EVENT_LOG_CAPACITY - 1)];
+        // only waits when the writer is a whole ring behind
+        while(slot->seq.load(memory_order_acquire) != pos + k){
+            this_thread::yield();
+        }
+        slot->record.index = STRIDE * indices[k] + offset;
+        slot->record.type = type;
+        slot->record.epoch = epoch;
+        slot->seq.store(pos + k + 1, memory_order_release);
+    }
+}
+
+#endif // EVENTLOG_H
@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "EventLog.h"
+
+/*
+ * Prints event logs written by EventLog as text, one event per line, in
+ * the format the controller used to print to stdout. Rotated files are
+ * given oldest first: event_log_dump events.bin.2 events.bin.1 events.bin
+ */
+
+using namespace std;
+
+int dump(const char *path){
+    FILE *file = fopen(path, "rb");
+    if(file == nullptr){
+        fprintf(stderr, "Could not open %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+
+    EventLogHeader header;
+    if(fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, EVENT_LOG_MAGIC, sizeof(header.magic)) != 0){
+        fprintf(stderr, "%s is not an event log\n", path);
+        fclose(file);
+        return 1;
+    }
+    if(header.version != EVENT_LOG_VERSION || header.record_size != sizeof(EventRecord)){
+        fprintf(stderr, "%s has version %u with %u byte records, expected version %u with %zu byte records\n",
+                path, header.version, header.record_size, EVENT_LOG_VERSION, sizeof(EventRecord));
+        fclose(file);
+        return 1;
+    }
+
+    EventRecord records[4096];
+    size_t n;
+    while((n = fread(records, sizeof(EventRecord), 4096, file)) > 0){
+        for(size_t i = 0; i < n; i++){
+            EventRecord &record = records[i];
+            switch(record.type){
+                case EVENT_EPOCH: {
+                    time_t t = record.index;
+                    char buf[100];
+                    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S UTC", gmtime(&t));
+                    printf("[%s]: Epoch %u\n", buf, record.epoch);
+                    break;
+                }
+                case EVENT_ACTIVATED:
+                    printf("Activated %u\n", record.index);
+                    break;
+                case EVENT_EXPIRED:
+                    printf("Expired %u\n", record.index);
+                    break;
+                case EVENT_FLAG:
+                    printf("Flag %u\n", record.index);
+                    break;
+                case EVENT_HOLD:
+                    printf("Global %u\n", record.index);
+                    break;
+                default:
+                    printf("Unknown %u %u\n", record.type, record.index);
+                    break;
+            }
+        }
+    }
+
+    fclose(file);
+    return 0;
+}
+
+int main(int argc, char **argv){
+    if(argc < 2){
+        fprintf(stderr, "Usage: %s <event log>...\n", argv[0]);
+        return 1;
+    }
+
+    int status = 0;
+    for(int i = 1; i < argc; i++){
+        status |= dump(argv[i]);
+    }
+    return status;
+}
@@ -0,0 +1,31 @@
+#ifndef FLAGDIGEST_H // Include guards to prevent multiple inclusion
+
+#define FLAGDIGEST_H
+
+#include <stdint.h>
+#include <vector>
+#include <functional>
+
+using namespace std;
+
+// a flag_table entry set for the first time since the controller reset it
+struct FlagEvent {
+    uint32_t idx;       // register index
+    uint32_t bank;
+};
+
+// receives the batches of events, on a thread of the backend
+typedef function<void(const vector<FlagEvent> &events)> FlagDigestCallback;
+
+// learn digests the ingress sends when it sets a flag (flag_digest in telescope.p4)
+class FlagDigest {
+    public:
+        virtual ~FlagDigest() {}
+
+        virtual void subscribe(FlagDigestCallback callback) = 0;
+
+        // digests skipped since the last call because their fields could not be read
+        virtual uint64_t take_skipped() = 0;
+};
+
+#endif // FLAGDIGEST_H
@@ -0,0 +1,61 @@
+#include "FlagQueue.h"
+
+FlagQueue::FlagQueue(){
+    // slot i is free for the event with sequence number i
+    ring = new Slot[FLAG_QUEUE_CAPACITY];
+    for(uint64_t i = 0; i < FLAG_QUEUE_CAPACITY; i++){
+        ring[i].seq.store(i, memory_order_relaxed);
+    }
+    head = 0;
+    tail = 0;
+    dropped = 0;
+}
+
+FlagQueue::~FlagQueue(){
+    delete[] ring;
+}
+
+bool FlagQueue::push(const FlagEvent &event){
+    uint64_t pos = head.load(memory_order_relaxed);
+    while(true){
+        Slot *slot = &ring[pos & (FLAG_QUEUE_CAPACITY - 1)];
+        uint64_t seq = slot->seq.load(memory_order_acquire);
+        if(seq == pos){
+            if(head.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)){
+                slot->event = event;
+                slot->seq.store(pos + 1, memory_order_release);
+                return true;
+            }
+        }
+        else if(seq < pos){
+            // the consumer has not freed this slot yet: full
+            dropped.fetch_add(1, memory_order_relaxed);
+            return false;
+        }
+        else{
+            pos = head.load(memory_order_relaxed);
+        }
+    }
+}
+
+uint64_t FlagQueue::drain(vector<vector<uint64_t>> &bitmaps){
+    uint64_t count = 0;
+    while(true){
+        Slot *slot = &ring[tail & (FLAG_QUEUE_CAPACITY - 1)];
+        if(slot->seq.load(memory_order_acquire) != tail + 1){
+            break;
+        }
+        const FlagEvent &event = slot->event;
+        if(event.bank < bitmaps.size() && event.idx / 64 < bitmaps[event.bank].size()){
+            bitmaps[event.bank][event.idx / 64] |= 1ULL << (event.idx % 64);
+        }
+        slot->seq.store(tail + FLAG_QUEUE_CAPACITY, memory_order_release);
+        tail++;
+        count++;
+    }
+    return count;
+}
+
+uint64_t FlagQueue::take_dropped(){
+    return dropped.exchange(0, memory_order_relaxed);
+}
@@ -0,0 +1,51 @@
+#ifndef FLAGQUEUE_H // Include guards to prevent multiple inclusion
+
+#define FLAGQUEUE_H
+
+#include <stdint.h>
+#include <vector>
+#include <atomic>
+
+#include "FlagDigest.h"
+
+// slots in the ring, a power of two
+#define FLAG_QUEUE_CAPACITY (1 << 20)
+
+using namespace std;
+
+/*
+ * Lock-free queue between the learn callbacks and the epoch.
+ *
+ * Producers claim a slot with a compare-and-swap on head and publish it
+ * through the slot's sequence number, as in the event log ring, but never
+ * wait: an event that finds the ring full is dropped and counted, since
+ * the backend thread must not stall. A single consumer drains the ring
+ * between epochs.
+ */
+class FlagQueue {
+    private:
+        struct Slot {
+            atomic<uint64_t> seq;
+            FlagEvent event;
+        };
+
+        Slot *ring;
+        atomic<uint64_t> head;
+        uint64_t tail;
+        atomic<uint64_t> dropped;
+    public:
+        FlagQueue();
+
+        ~FlagQueue();
+
+        // false if the ring is full and the event was dropped
+        bool push(const FlagEvent &event);
+
+        // sets bit idx of bitmaps[bank] for every queued event; returns the number of events
+        uint64_t drain(vector<vector<uint64_t>> &bitmaps);
+
+        // events dropped since the last call
+        uint64_t take_dropped();
+};
+
+#endif // FLAGQUEUE_H
@@ -0,0 +1,17 @@
+#ifndef FORWARDTABLE_H // Include guards to prevent multiple inclusion
+
+#define FORWARDTABLE_H
+
+#include <stdint.h>
+
+using namespace std;
+
+class ForwardTable {
+    public:
+        virtual ~ForwardTable() {}
+
+        virtual void add_entry(const uint16_t &ingress_port,
+                                const uint16_t &egress_port) = 0;
+};
+
+#endif // FORWARDTABLE_H
\ No newline at end of file
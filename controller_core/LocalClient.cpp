@@ -0,0 +1,644 @@
+#include "LocalClient.h"
+
+string getCurrentDateTimeUTC() {
+    time_t now = time(nullptr);
+    char buf[100];
+    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S UTC", gmtime(&now));
+    return string(buf);
+}
+
+template <class Program>
+LocalClient<Program>::LocalClient(Args<Program>* args, Backend *backend) {
+    this->backend = backend;
+    session = backend->session_create();
+
+    // parse args
+    time_interval = args->time_interval;
+    global_table_size = args->global_table_size;
+    dark_meter_size = args->dark_meter_size;
+    max_pkt_rate = args->max_pkt_rate;
+    avg_pkt_rate = args->avg_pkt_rate;
+    max_byte_rate = args->max_byte_rate;
+    avg_byte_rate = args->avg_byte_rate;
+    alpha = args->alpha;
+    monitored_path = args->monitored_path;
+    prefixes_path = args->prefixes_path;
+    ports["incoming"] = args->incoming; //{133};
+    ports["outgoing"] = args->outgoing; //{132};
+
+    aging = args->aging;
+    workers = args->workers;
+    reconcile_every = args->reconcile_every;
+    flag_digest = nullptr;
+    flag_queue = nullptr;
+    if(aging == "counters"){
+        counters = vector<uint16_t> (global_table_size * Index::BANKS, alpha);
+    }
+
+    cout << "outgoing size " << ports["outgoing"].size() << endl;
+    cout << "incoming size " << ports["incoming"].size() << endl;
+    cout << "alpha: " + to_string(alpha) << endl;
+    cout << "aging: " + aging << endl;
+
+    // track total number of monitored addresses
+    addr_cnt = 0;
+
+    metrics = new Metrics;
+    event_log = new EventLog(args->event_log_path, args->event_log_level, (uint64_t) args->event_log_size << 20);
+    metrics->interval_seconds = time_interval;
+    checkpoint = new Checkpoint(args->checkpoint_path, args->checkpoint_every, Index::BANKS, alpha, time_interval);
+    epoch = 0;
+
+    setup();
+    if(args->learn){
+        subscribe_flags();
+    }
+
+    metrics->monitored_addr = addr_cnt;
+    // address index BANKS * i + t is register index i of bank t, as in the prefix map
+    activity_feed = new ActivityFeed(args->activity_feed, addr_cnt, time_interval * 1000, alpha > 0);
+    if(checkpoint->enabled()){
+        restore_checkpoint();
+    }
+    metrics_server = new MetricsServer(metrics, args->metrics_port, args->metrics_socket);
+    metrics_server->start();
+}
+
+template <class Program>
+void LocalClient<Program>::add_mirroring(vector<uint16_t> router_ports, uint16_t mc_session_id, uint16_t log_session_id, uint16_t pkt_len, uint16_t log_port){
+    /* border routers*/
+    uint16_t rid = 1;
+    vector<uint16_t> rids;
+
+    for(auto val: router_ports){
+        for(int i = 0; i < 3; i++){ // 3 pkts per router
+            cout << "Adding node: " << rid << " with port: " << val << endl;
+            node->add_node(rid, val);
+            rids.push_back(rid);
+            rid++;
+        }
+    }
+
+    mc_group->add_group(1, rids);
+
+    /* recirculation nodes */
+    vector<uint16_t> rec_ports;
+    for(uint32_t i = 0; i < Program::NUM_PIPES; i++){
+        rec_ports.push_back(Program::RECIRCULATE_PORT + 128*i);
+    }
+
+    rids.clear();
+    for(auto val: rec_ports){
+        node->add_node(rid, val);
+        rids.push_back(rid);
+        rid++;
+    }
+
+    mc_group->add_group(2, rids);
+    mirror->add_mirror_group(mc_session_id, 1, 2, pkt_len);
+    mirror->add_mirror_port(log_session_id, log_port);
+}
+
+template <class Program>
+vector<string> LocalClient<Program>::parse_monitored(string path){
+    vector<string> monitored_pfx;
+
+    ifstream file(path);
+    if(file.is_open()){
+        string prefix;
+        while(getline(file, prefix)){
+            monitored_pfx.push_back(prefix);
+        }
+    } else{
+        printf("Error in opening monitored prefixes file");
+        exit(1);
+    }
+    file.close();
+    return monitored_pfx;
+}
+
+template <class Program>
+void LocalClient<Program>::populate_monitored(vector<string> entries){
+    // locals, so that a second controller in the process, as in the bench, starts at 0 too
+    uint32_t base_idx = 0;
+    uint32_t dark_base_idx = 0;
+    uint32_t mask;
+    string prefix, length;
+    size_t pos;
+
+    for(string entry: entries){
+        pos = entry.find('/');
+        if (pos != string::npos) {
+            prefix = entry.substr(0, pos);
+            length = entry.substr(pos + 1);
+        }
+        else {
+            continue;
+        }
+        vector<uint8_t> addr(Program::Family::ADDR_BYTES);
+        if(!Index::parse(prefix, addr.data())){
+            printf("Invalid monitored prefix %s\n", entry.c_str());
+            exit(1);
+        }
+        mask = Index::mask(stoi(length));
+
+        monitored_table->add_entry(addr, stoi(length), base_idx, mask, dark_base_idx);
+
+        // one index per unit: register index i of bank t is BANKS * i + t
+        PrefixMapRecord record = {};
+        copy(addr.begin(), addr.end(), record.addr);
+        record.base_idx = base_idx * Index::BANKS;
+        record.family = Program::Family::FAMILY;
+        record.prefix_len = stoi(length);
+        record.unit_len = Program::Family::UNIT_LEN;
+        prefix_map.push_back(record);
+
+        cout << "Prefix: " << prefix << " Length: " << length << endl;
+        cout << "Mask " << mask << endl;
+        base_idx += (mask + 1);
+        addr_cnt += (mask + 1) * Index::BANKS;
+        if constexpr (Program::DARK_PREFIX_LEN != 0){
+            dark_base_idx += pow(2, (int) Program::DARK_PREFIX_LEN - stoi(length));
+        }
+    }
+
+    if(!prefixes_path.empty() && !write_prefix_map(prefixes_path, prefix_map)){
+        printf("Error in writing the prefix map %s\n", prefixes_path.c_str());
+        exit(1);
+    }
+}
+
+template <class Program>
+void LocalClient<Program>::add_ports(unordered_map<string, vector<uint16_t>> ports){
+    for(auto port: ports["incoming"]){
+        ports_table->add_entry(port, false);
+    }
+    for(auto port: ports["outgoing"]){
+        ports_table->add_entry(port, true);
+    }
+}
+
+template <class Program>
+void LocalClient<Program>::set_rates(){
+    dark_global_meter->add_entry(avg_pkt_rate, max_pkt_rate, 0);
+    // initially it's fine to have all meters with the same rate; they will be updated accordingly later
+    for(uint32_t i = 0; i < dark_meter_size; i++){
+        dark_meter_cache->set(avg_pkt_rate, max_pkt_rate, i);
+    }
+    dark_meter_cache->flush();
+}
+
+template <class Program>
+void LocalClient<Program>::update_rates(const vector<uint32_t> &inactive_pfxs, uint32_t inactive_addr){
+    if (inactive_addr == 0)
+        return;
+    uint32_t addr_avg_pkt_rate = ceil(avg_pkt_rate / (double) inactive_addr);
+    uint32_t addr_max_pkt_rate = ceil(max_pkt_rate / (double) inactive_addr);
+    uint32_t prefix_max_pkt_rate, prefix_avg_pkt_rate;
+
+    cout << avg_pkt_rate << " " << inactive_addr << " " << addr_avg_pkt_rate << endl;
+    cout << max_pkt_rate << " " << inactive_addr << " " << addr_max_pkt_rate << endl;
+
+    for(uint32_t mtr_idx = 0; mtr_idx < inactive_pfxs.size(); mtr_idx++){
+        uint32_t in_addr = inactive_pfxs[mtr_idx];
+        if(in_addr == 0){
+            continue;
+        }
+        prefix_max_pkt_rate = ceil(addr_max_pkt_rate * in_addr);
+        prefix_avg_pkt_rate = ceil(addr_avg_pkt_rate * in_addr);
+
+        dark_meter_cache->set(prefix_avg_pkt_rate, prefix_max_pkt_rate, mtr_idx);
+    }
+
+    // only the entries whose rates changed are written
+    uint32_t written = dark_meter_cache->flush();
+    metrics->meter_updates += written;
+    cout << "Meter entries written: " << written << endl;
+}
+
+template <class Program>
+void LocalClient<Program>::set_forward(unordered_map<uint16_t, uint16_t> port_pairs){
+    for(auto port_pair: port_pairs){
+        forward_table->add_entry(port_pair.first, port_pair.second);
+    }
+}
+
+template <class Program>
+void LocalClient<Program>::setup(){
+    // enable switch ports
+    port_mgr = backend->new_port_manager(session);
+    port_mgr->port_enable(164, "BF_SPEED_100G");
+    port_mgr->port_enable(172, "BF_SPEED_100G");
+    port_mgr->port_enable(180, "BF_SPEED_100G");
+    port_mgr->port_enable(188, "BF_SPEED_100G");
+    port_mgr->port_enable(56, "BF_SPEED_100G");
+    port_mgr->port_enable(48, "BF_SPEED_100G");
+    port_mgr->port_enable(40, "BF_SPEED_100G");
+    port_mgr->port_enable(32, "BF_SPEED_100G");
+    port_mgr->port_enable(24, "BF_SPEED_100G");
+
+    // get objects
+    ports_table = backend->new_ports_table(session);
+    monitored_table = backend->new_monitored_table(session);
+    forward_table = backend->new_forward_table(session);
+    node = backend->new_node(session);
+    mc_group = backend->new_multicast_group(session);
+    mirror = backend->new_mirror_manager(session);
+
+    for(uint32_t t = 0; t < Index::BANKS; t++){
+        global_tables.push_back(backend->new_register(Index::register_name("global_table", t), session));
+        flag_tables.push_back(backend->new_register(Index::register_name("flag_table", t), session));
+    }
+
+    dark_meter = nullptr;
+    dark_meter_cache = nullptr;
+    dark_global_meter = nullptr;
+    if constexpr (Program::HAS_METERS){
+        dark_meter = backend->new_meter("pipe.Ingress.dark_meter", session);
+        dark_meter_cache = new MeterCache(dark_meter, dark_meter_size);
+        dark_global_meter = backend->new_meter("pipe.Ingress.dark_global_meter", session);
+    }
+
+    vector<uint16_t> router_ports;
+
+    cout<<"Setting mirroring\n";
+    add_mirroring(router_ports, 1, 2, Program::MIRROR_PKT_LEN, Program::LOG_PORT);
+    cout<<"Done with mirroring setup\n";
+    monitored_prefixes = parse_monitored(monitored_path);
+    cout << "Populating monitored IPv" << (int) Program::Family::FAMILY << "\n";
+    populate_monitored(monitored_prefixes);
+    add_ports(ports);
+    set_forward(port_pairs);
+    if constexpr (Program::HAS_METERS){
+        set_rates();
+    }
+    add_shards();
+}
+
+template <class Program>
+void LocalClient<Program>::add_shards(){
+    uint32_t bank_size = addr_cnt / Index::BANKS;
+    uint32_t shard_size = (bank_size + workers - 1) / workers;
+    shard_size = (shard_size + SHARD_ALIGN - 1) / SHARD_ALIGN * SHARD_ALIGN;
+
+    for(uint32_t start_idx = 0; start_idx < bank_size; start_idx += shard_size){
+        Shard *shard = new Shard;
+        shard->start_idx = start_idx;
+        shard->end_idx = min(start_idx + shard_size, bank_size);
+
+        // the first shard writes on the main session, the others get their own
+        shard->read_session = backend->session_create();
+        if(shards.empty()){
+            shard->write_session = session;
+            shard->flag_tables = flag_tables;
+            shard->global_tables = global_tables;
+        }
+        else{
+            shard->write_session = backend->session_create();
+        }
+
+        for(uint32_t t = 0; t < Index::BANKS; t++){
+            string flag_name = Index::register_name("flag_table", t);
+            string global_name = Index::register_name("global_table", t);
+
+            shard->flag_readers.push_back(backend->new_register(flag_name, shard->read_session));
+            if(shard->write_session != session){
+                shard->flag_tables.push_back(backend->new_register(flag_name, shard->write_session));
+                shard->global_tables.push_back(backend->new_register(global_name, shard->write_session));
+            }
+            if(aging != "counters"){
+                shard->wheels.push_back(new AgingWheel(shard->end_idx - start_idx, alpha, Program::METER_SHIFT));
+            }
+        }
+        shard->pipeline = new BankPipeline(Index::BANKS);
+        shards.push_back(shard);
+    }
+    cout << "Workers: " << shards.size() << endl;
+}
+
+template <class Program>
+void LocalClient<Program>::subscribe_flags(){
+    uint32_t bank_size = addr_cnt / Index::BANKS;
+    learned_flags.assign(Index::BANKS, vector<uint64_t>((bank_size + 63) / 64, 0));
+    flag_queue = new FlagQueue;
+    flag_digest = backend->new_flag_digest(session);
+    flag_digest->subscribe([this](const vector<FlagEvent> &events){
+        for(auto &event: events){
+            flag_queue->push(event);
+        }
+    });
+    cout << "Learning flags, reconciling every " << reconcile_every << " epochs" << endl;
+}
+
+static double elapsed_ms(chrono::steady_clock::time_point start){
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// sync every bank once; used when several shards read the same banks.
+// One bank at a time: the driver may run all the sync callbacks on one
+// thread, which must not block on the lock of a bank still waited for
+template <class Program>
+void LocalClient<Program>::sync_flags(){
+    for(auto flag_table: shards[0]->flag_readers){
+        auto start = chrono::steady_clock::now();
+        unique_lock<mutex> flag_lock = flag_table->start_sync();
+        flag_table->end_sync(flag_lock);
+        metrics->register_sync.record(elapsed_ms(start) * 1000);
+    }
+}
+
+// shards cover whole dark_meter indices, so each one only touches its own part of inactive_pfxs
+template <class Program>
+void LocalClient<Program>::run_shard(Shard *shard, vector<uint32_t> &inactive_pfxs, bool scan){
+    uint32_t n = shard->end_idx - shard->start_idx;
+    // counted from the expired indices instead with RATES_FROM_EXPIRED
+    uint32_t *shard_pfxs = nullptr;
+    if constexpr (Program::HAS_METERS && !Program::RATES_FROM_EXPIRED){
+        shard_pfxs = &inactive_pfxs[shard->start_idx >> Program::METER_SHIFT];
+    }
+
+    shard->cur_active_addr_cnt = 0;
+    shard->active_addr_cnt = 0;
+    shard->inactive_addr = 0;
+    shard->stats.clear();
+
+    shard->pipeline->run(
+        [&](uint32_t t, vector<uint64_t> &flags){
+            auto phase_start = chrono::steady_clock::now();
+            // shards start on a whole flag word
+            const uint64_t *learned = learned_flags.empty() ? nullptr : &learned_flags[t][shard->start_idx / 64];
+            if(!scan){
+                flags.assign(learned, learned + (n + 63) / 64);
+                shard->stats.read_ms += elapsed_ms(phase_start);
+                return;
+            }
+            if(shards.size() == 1){
+                unique_lock<mutex> flag_lock = shard->flag_readers[t]->start_sync();
+                shard->flag_readers[t]->end_sync(flag_lock);
+                shard->stats.sync_ms += elapsed_ms(phase_start);
+                metrics->register_sync.record(elapsed_ms(phase_start) * 1000);
+                phase_start = chrono::steady_clock::now();
+            }
+            shard->flag_readers[t]->get_entries_bitmap(shard->start_idx, shard->end_idx - 1, flags);
+            // digests that arrived since the sync
+            if(learned != nullptr){
+                for(uint32_t w = 0; w < flags.size(); w++){
+                    flags[w] |= learned[w];
+                }
+            }
+            shard->stats.read_ms += elapsed_ms(phase_start);
+        },
+        [&](uint32_t t, const vector<uint64_t> &flags){
+            BankUpdate &update = shard->update;
+            auto phase_start = chrono::steady_clock::now();
+
+            update.clear();
+            update.collect_hold = event_log->enabled(EVENT_HOLD);
+            if(shard->wheels.empty()){
+                epoch_update(flags.data(), &counters[t * global_table_size + shard->start_idx], n, alpha,
+                                Program::METER_SHIFT, shard_pfxs, update);
+            }
+            else{
+                shard->wheels[t]->update(flags.data(), shard_pfxs, update);
+            }
+            update.offset(shard->start_idx);
+
+            shard->cur_active_addr_cnt += update.cur_active_addr_cnt;
+            shard->active_addr_cnt += update.active_addr_cnt;
+            if constexpr (Program::RATES_FROM_EXPIRED){
+                // only the addresses that expired in this epoch count towards the rates
+                for(auto i: update.inactive_indices){
+                    inactive_pfxs[i >> Program::METER_SHIFT]++;
+                }
+                shard->inactive_addr += update.inactive_indices.size();
+            }
+            else{
+                shard->inactive_addr += update.inactive_addr;
+            }
+            shard->stats.classify_ms += elapsed_ms(phase_start);
+
+            event_log->log<Index::BANKS>(EVENT_FLAG, update.flag_indices, t);
+            event_log->log<Index::BANKS>(EVENT_HOLD, update.hold_indices, t);
+            event_log->log<Index::BANKS>(EVENT_ACTIVATED, update.global_indices, t);
+            event_log->log<Index::BANKS>(EVENT_EXPIRED, update.inactive_indices, t);
+            activity_feed->update<Index::BANKS>(update.global_indices, t, true);
+            activity_feed->update<Index::BANKS>(update.inactive_indices, t, false);
+
+            {
+                lock_guard<mutex> lck(print_lock);
+                cout << "Size of global to active: " << update.global_indices.size() << endl;
+                cout << "Size of global to inactive: " << update.inactive_indices.size() << endl;
+                cout << "Size of flags: " << update.flag_indices.size() << endl;
+            }
+
+            metrics->global_batch.record(update.global_indices.size());
+            metrics->global_batch.record(update.inactive_indices.size());
+            metrics->flag_batch.record(update.flag_indices.size());
+
+            phase_start = chrono::steady_clock::now();
+            shard->global_tables[t]->add_entries(update.global_indices, 1);
+            shard->global_tables[t]->add_entries(update.inactive_indices, 0);
+            shard->stats.global_write_ms += elapsed_ms(phase_start);
+
+            phase_start = chrono::steady_clock::now();
+            shard->flag_tables[t]->add_entries(update.flag_indices, 0);
+            shard->stats.flag_reset_ms += elapsed_ms(phase_start);
+        });
+}
+
+template <class Program>
+void LocalClient<Program>::save_checkpoint(){
+    auto start = chrono::steady_clock::now();
+    uint16_t *saved = checkpoint->begin(epoch, prefix_map, addr_cnt);
+    if(saved == nullptr){
+        return;
+    }
+
+    // register index i of bank t is address index BANKS * i + t
+    for(auto shard: shards){
+        for(uint32_t t = 0; t < Index::BANKS; t++){
+            uint16_t *out = &saved[(uint64_t) Index::BANKS * shard->start_idx + t];
+            if(shard->wheels.empty()){
+                for(uint32_t i = shard->start_idx; i < shard->end_idx; i++){
+                    *out = counters[t * global_table_size + i];
+                    out += Index::BANKS;
+                }
+            }
+            else{
+                shard->wheels[t]->get_counters(out, Index::BANKS);
+            }
+        }
+    }
+
+    if(checkpoint->commit()){
+        cout << "Checkpoint of epoch " << epoch << " written in " << (uint64_t) elapsed_ms(start) << " ms" << endl;
+    }
+}
+
+template <class Program>
+void LocalClient<Program>::restore_checkpoint(){
+    vector<uint16_t> saved;
+    if(!checkpoint->load(prefix_map, addr_cnt, saved, epoch)){
+        return;
+    }
+
+    uint32_t bank_size = addr_cnt / Index::BANKS;
+    for(auto shard: shards){
+        for(uint32_t t = 0; t < Index::BANKS; t++){
+            const uint16_t *in = &saved[(uint64_t) Index::BANKS * shard->start_idx + t];
+            if(shard->wheels.empty()){
+                for(uint32_t i = shard->start_idx; i < shard->end_idx; i++){
+                    counters[t * global_table_size + i] = *in;
+                    in += Index::BANKS;
+                }
+            }
+            else{
+                shard->wheels[t]->set_counters(in, Index::BANKS);
+            }
+        }
+    }
+
+    // global_table is 1 while an address is active; a data plane that kept
+    // running still holds the right values, so only the differences are written
+    uint32_t restored_inactive = 0;
+    for(uint32_t t = 0; t < Index::BANKS; t++){
+        vector<uint64_t> global;
+        unique_lock<mutex> global_lock = global_tables[t]->start_sync();
+        global_tables[t]->end_sync(global_lock);
+        global_tables[t]->get_entries_bitmap(0, bank_size - 1, global);
+
+        vector<uint32_t> to_active, to_inactive, inactive;
+        for(uint32_t i = 0; i < bank_size; i++){
+            bool active = saved[(uint64_t) Index::BANKS * i + t] != 0;
+            bool set = (global[i / 64] >> (i % 64)) & 1;
+            if(!active){
+                inactive.push_back(i);
+            }
+            if(active && !set){
+                to_active.push_back(i);
+            }
+            else if(!active && set){
+                to_inactive.push_back(i);
+            }
+        }
+        global_tables[t]->add_entries(to_active, 1);
+        global_tables[t]->add_entries(to_inactive, 0);
+        activity_feed->update<Index::BANKS>(inactive, t, false);
+        restored_inactive += inactive.size();
+        cout << "Restored global_table " << t << ": " << to_active.size() << " set active, "
+                << to_inactive.size() << " set inactive" << endl;
+    }
+    activity_feed->publish();
+    event_log->resume(epoch);
+    cout << "Inactive addr: " << restored_inactive << " out of " << addr_cnt << endl;
+}
+
+template <class Program>
+EpochStats LocalClient<Program>::run_epoch(){
+    auto start = chrono::steady_clock::now();
+    EpochStats stats;
+    stats.clear();
+
+    cout << "[" << getCurrentDateTimeUTC() << "]: Start of iteration\n";
+    event_log->start_epoch();
+
+    inactive_pfxs.assign(((addr_cnt / Index::BANKS) >> Program::METER_SHIFT) + 1, 0);
+    uint32_t inactive_addr = 0;
+    uint32_t cur_active_addr_cnt = 0;
+    uint32_t active_addr_cnt = 0;
+
+    // flag_table is read every epoch, or with digests only to catch the ones lost
+    // in the driver or the queue, whose flags stay set without a new digest
+    bool scan = true;
+    if(flag_queue != nullptr){
+        for(auto &bitmap: learned_flags){
+            fill(bitmap.begin(), bitmap.end(), 0);
+        }
+        metrics->flag_digests += flag_queue->drain(learned_flags);
+        uint64_t dropped = flag_queue->take_dropped();
+        metrics->flag_digest_drops += dropped;
+        uint64_t skipped = flag_digest->take_skipped();
+        metrics->flag_digest_skips += skipped;
+        dropped += skipped;
+        scan = dropped > 0 || epoch % reconcile_every == 0;
+        if(scan){
+            cout << "Reconciling flags, " << dropped << " digests dropped" << endl;
+        }
+    }
+    if(scan){
+        metrics->flag_scans++;
+    }
+
+    if(shards.size() == 1){
+        run_shard(shards[0], inactive_pfxs, scan);
+    }
+    else{
+        if(scan){
+            auto phase_start = chrono::steady_clock::now();
+            sync_flags();
+            stats.sync_ms += elapsed_ms(phase_start);
+        }
+
+        vector<thread> threads;
+        for(auto shard: shards){
+            threads.emplace_back(&LocalClient::run_shard, this, shard, ref(inactive_pfxs), scan);
+        }
+        for(auto &worker: threads){
+            worker.join();
+        }
+    }
+    cout << "End of writing\n";
+    activity_feed->publish();
+
+    for(auto shard: shards){
+        cur_active_addr_cnt += shard->cur_active_addr_cnt;
+        active_addr_cnt += shard->active_addr_cnt;
+        inactive_addr += shard->inactive_addr;
+        stats.add(shard->stats);
+    }
+
+    cout << "Cur active addr: " << cur_active_addr_cnt << endl;
+    cout << "Active addr: " << active_addr_cnt << " out of " << addr_cnt << endl;
+
+    auto stop = chrono::steady_clock::now();
+    auto duration = chrono::duration_cast<chrono::microseconds>(stop - start);
+
+    cout << "[" << getCurrentDateTimeUTC() << "]: Time taken by iteration: " << duration.count() / 1000000 << " seconds" << endl;
+
+    if constexpr (Program::HAS_METERS){
+        auto phase_start = chrono::steady_clock::now();
+        update_rates(inactive_pfxs, inactive_addr);
+        stats.meter_update_ms = elapsed_ms(phase_start);
+        cout << "Finished rates\n";
+    }
+
+    stats.total_ms = elapsed_ms(start);
+    metrics->cur_active_addr = cur_active_addr_cnt;
+    metrics->active_addr = active_addr_cnt;
+    metrics->inactive_addr = inactive_addr;
+    metrics->record_epoch(stats);
+    epoch++;
+    if(checkpoint->due(epoch)){
+        save_checkpoint();
+    }
+    cout << "[" << getCurrentDateTimeUTC() << "]: Time taken by function: " << (uint64_t) stats.total_ms / 1000 << " seconds" << endl;
+
+    return stats;
+}
+
+template <class Program>
+void LocalClient<Program>::run(){
+    while(true){
+        auto start = chrono::steady_clock::now();
+
+        run_epoch();
+
+        this_thread::sleep_for(chrono::milliseconds(time_interval * 1000) -
+                                chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start));
+    }
+}
+
+#ifdef PROGRAM
+// the program this build is for, see Programs.h
+template class LocalClient<PROGRAM>;
+#endif
@@ -0,0 +1,209 @@
+#ifndef LOCALCLIENT_H // Include guards to prevent multiple inclusion
+
+#define LOCALCLIENT_H
+
+#include <cmath>
+#include <chrono>
+#include <thread> 
+#include <mutex>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include "Backend.h"
+#include "EpochKernel.h"
+#include "AgingWheel.h"
+#include "BankPipeline.h"
+#include "Metrics.h"
+#include "MetricsServer.h"
+#include "EventLog.h"
+#include "MeterCache.h"
+#include "PrefixMap.h"
+#include "ActivityFeed.h"
+#include "Checkpoint.h"
+#include "FlagQueue.h"
+#include "Programs.h"
+
+// shard boundaries fall on whole flag words and dark_meter indices
+#define SHARD_ALIGN 1024
+
+using namespace std;
+
+template <class Program>
+struct Args {
+    uint16_t time_interval = 100;
+    uint32_t global_table_size = Program::GLOBAL_TABLE_SIZE;
+    uint32_t dark_meter_size = 16384;
+    uint32_t max_pkt_rate = 1174405;
+    uint32_t avg_pkt_rate = 343933;
+    uint32_t max_byte_rate = 338102845;
+    uint32_t avg_byte_rate = 17758683;
+    uint16_t alpha = 216;
+    string monitored_path = "monitored.txt";
+    // map of the monitored prefixes to indices for the capture application; empty to skip
+    string prefixes_path = "prefixes.bin";
+    string aging = "wheel";
+    uint16_t workers = 1;
+    // metrics listeners; 0 and empty to disable
+    uint16_t metrics_port = 0;
+    string metrics_socket = "";
+    // binary log of address events, see EventLog.h; an empty path disables it
+    string event_log_path = "events.bin";
+    EventLevel event_log_level = EVENT_LEVEL_FLAGS;
+    uint32_t event_log_size = 64;       // MB per file before rotating
+    // shared memory object publishing the active addresses, see ActivityFeed.h; empty to disable
+    string activity_feed = "";
+    // aging state restored on startup and written every checkpoint_every epochs, see Checkpoint.h; empty to disable
+    string checkpoint_path = "";
+    uint32_t checkpoint_every = 1;
+    // learn the flagged addresses from digests and read all of flag_table only every reconcile_every epochs
+    bool learn = false;
+    uint32_t reconcile_every = 16;
+    vector<uint16_t> outgoing = {Program::OUTGOING_PORT};
+    vector<uint16_t> incoming = {Program::INCOMING_PORT};
+};
+
+// register indices [start_idx, end_idx) of every bank, handled by one worker
+struct Shard {
+    uint32_t start_idx;
+    uint32_t end_idx;
+
+    // reads and writes run concurrently, so each side has its own session
+    shared_ptr<BackendSession> read_session;
+    shared_ptr<BackendSession> write_session;
+    vector<Register *> flag_readers;
+    vector<Register *> flag_tables;
+    vector<Register *> global_tables;
+
+    vector<AgingWheel *> wheels;
+    BankPipeline *pipeline;
+    BankUpdate update;
+
+    uint32_t cur_active_addr_cnt;
+    uint32_t active_addr_cnt;
+    uint32_t inactive_addr;
+    EpochStats stats;
+};
+
+/*
+ * Controller of one telescope program, specialized at compile time by its
+ * traits (see Programs.h): the bank loop, the index math and the rate
+ * accounting only keep what the program needs.
+ */
+template <class Program>
+class LocalClient{
+    private:
+        typedef ProgramIndex<Program> Index;
+    public:
+        uint32_t global_table_size;
+        string monitored_path;
+        string prefixes_path;
+        vector<string> monitored_prefixes;
+        // every prefix populated so far, rewritten to prefixes_path
+        vector<PrefixMapRecord> prefix_map;
+        uint32_t addr_cnt;
+
+        // counters of bank t start at t * global_table_size
+        vector<uint16_t> counters;
+        // "wheel" ages with one AgingWheel per bank and shard, "counters" scans counters
+        string aging;
+        uint16_t alpha;
+        uint16_t time_interval;
+
+        unordered_map<string, vector<uint16_t>> ports;
+        unordered_map<uint16_t, uint16_t> port_pairs;
+
+        uint32_t dark_meter_size;
+        uint32_t max_pkt_rate;
+        uint32_t avg_pkt_rate;
+        uint32_t max_byte_rate;
+        uint32_t avg_byte_rate;
+
+        Backend *backend;
+        shared_ptr<BackendSession> session;
+        PortManager *port_mgr;
+        Node *node;
+        MulticastGroup *mc_group;
+        MirrorManager *mirror;
+        PortsTable *ports_table;
+        MonitoredTable *monitored_table;
+        ForwardTable *forward_table;
+        vector<Register *> global_tables;
+        vector<Register *> flag_tables;
+
+        // flags learned from the digests, or nullptr when flag_table is read every epoch
+        FlagDigest *flag_digest;
+        FlagQueue *flag_queue;
+        // flags drained from the queue this epoch, one bitmap per bank
+        vector<vector<uint64_t>> learned_flags;
+        uint32_t reconcile_every;
+
+        // each shard is read, aged and written by its own thread
+        uint16_t workers;
+        vector<Shard *> shards;
+        mutex print_lock;
+        // inactive addresses per dark_meter index, or only the newly expired ones with RATES_FROM_EXPIRED
+        vector<uint32_t> inactive_pfxs;
+        Meter *dark_meter;
+        // rates last written to dark_meter
+        MeterCache *dark_meter_cache;
+        Meter *dark_global_meter;
+
+        Metrics *metrics;
+        MetricsServer *metrics_server;
+        EventLog *event_log;
+        ActivityFeed *activity_feed;
+        Checkpoint *checkpoint;
+        // epochs run, carried over by the checkpoints
+        uint64_t epoch;
+    public:
+        LocalClient(Args<Program>* args, Backend *backend);
+
+        void add_mirroring(vector<uint16_t> router_ports, uint16_t mc_session_id, uint16_t log_session_id, 
+                            uint16_t pkt_len, uint16_t log_port);
+
+        vector<string> parse_monitored(string path);
+
+        void populate_monitored(vector<string> entries);
+
+        void add_ports(unordered_map<string, vector<uint16_t>> ports);
+
+        void set_forward(unordered_map<uint16_t, uint16_t> port_pairs);
+
+        void set_rates();
+
+        void update_rates(const vector<uint32_t> &inactive_pfxs, uint32_t inactive_addr);
+
+        void setup();
+
+        void add_shards();
+
+        // starts learning the flags from digests instead of reading flag_table every epoch
+        void subscribe_flags();
+
+        void sync_flags();
+
+        // a scan reads the flags of the shard from flag_table, otherwise they are the learned ones
+        void run_shard(Shard *shard, vector<uint32_t> &inactive_pfxs, bool scan);
+
+        void save_checkpoint();
+
+        // loads the counters of the checkpoint and brings global_table, the
+        // activity feed and the event log in line with them
+        void restore_checkpoint();
+
+        // one read, classify and write-back pass over all banks, then the rate update
+        EpochStats run_epoch();
+
+        void run();
+};
+
+#endif // LOCALCLIENT_H
\ No newline at end of file
@@ -0,0 +1,27 @@
+#ifndef METER_H // Include guards to prevent multiple inclusion
+
+#define METER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct MeterEntry {
+    uint32_t idx;
+    uint32_t avg_pkt_rate;
+    uint32_t max_pkt_rate;
+};
+
+class Meter{
+    public:
+        virtual ~Meter() {}
+
+        virtual void add_entry(const uint32_t &avg_pkt_rate, const uint32_t &max_pkt_rate, const uint32_t &idx) = 0;
+
+        // writes all entries in one batch
+        virtual void add_entries(const vector<MeterEntry> &entries) = 0;
+};
+
+#endif // METER_H
\ No newline at end of file
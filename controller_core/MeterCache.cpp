@@ -0,0 +1,27 @@
+#include "MeterCache.h"
+
+MeterCache::MeterCache(Meter *meter, uint32_t size){
+    this->meter = meter;
+    avg_pkt_rates.assign(size, 0);
+    max_pkt_rates.assign(size, 0);
+    programmed.assign(size, false);
+}
+
+void MeterCache::set(const uint32_t &avg_pkt_rate, const uint32_t &max_pkt_rate, const uint32_t &idx){
+    if(programmed[idx] && avg_pkt_rates[idx] == avg_pkt_rate && max_pkt_rates[idx] == max_pkt_rate){
+        return;
+    }
+    avg_pkt_rates[idx] = avg_pkt_rate;
+    max_pkt_rates[idx] = max_pkt_rate;
+    programmed[idx] = true;
+    pending.push_back({idx, avg_pkt_rate, max_pkt_rate});
+}
+
+uint32_t MeterCache::flush(){
+    uint32_t written = pending.size();
+    if(written != 0){
+        meter->add_entries(pending);
+        pending.clear();
+    }
+    return written;
+}
@@ -0,0 +1,34 @@
+#ifndef METERCACHE_H // Include guards to prevent multiple inclusion
+
+#define METERCACHE_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "Meter.h"
+
+using namespace std;
+
+/*
+ * Last rates programmed in every entry of a meter. set() queues an entry
+ * only if its rates differ from the programmed ones and flush() writes
+ * the queued entries in one batch, so an epoch in which few rates change
+ * costs a few entry writes instead of one driver call per entry.
+ */
+class MeterCache {
+    private:
+        Meter *meter;
+        vector<uint32_t> avg_pkt_rates;
+        vector<uint32_t> max_pkt_rates;
+        vector<bool> programmed;
+        vector<MeterEntry> pending;
+    public:
+        MeterCache(Meter *meter, uint32_t size);
+
+        void set(const uint32_t &avg_pkt_rate, const uint32_t &max_pkt_rate, const uint32_t &idx);
+
+        // returns the number of entries written
+        uint32_t flush();
+};
+
+#endif // METERCACHE_H
@@ -0,0 +1,185 @@
+#include "Metrics.h"
+
+#include <stdlib.h>
+
+void EpochStats::clear(){
+    sync_ms = 0;
+    read_ms = 0;
+    classify_ms = 0;
+    global_write_ms = 0;
+    flag_reset_ms = 0;
+    meter_update_ms = 0;
+    total_ms = 0;
+}
+
+void EpochStats::add(const EpochStats &other){
+    sync_ms += other.sync_ms;
+    read_ms += other.read_ms;
+    classify_ms += other.classify_ms;
+    global_write_ms += other.global_write_ms;
+    flag_reset_ms += other.flag_reset_ms;
+    meter_update_ms += other.meter_update_ms;
+    total_ms += other.total_ms;
+}
+
+Histogram::Histogram(){
+    for(auto &bucket: buckets){
+        bucket = 0;
+    }
+    sum = 0;
+}
+
+uint32_t Histogram::bucket_index(uint64_t value){
+    if(value < HISTOGRAM_SUB_BUCKETS){
+        return value;
+    }
+    // sub-bucket bits below the leading one select the bucket in its power of two
+    uint32_t shift = 63 - __builtin_clzll(value) - __builtin_ctz(HISTOGRAM_SUB_BUCKETS);
+    uint32_t i = (shift + 1) * HISTOGRAM_SUB_BUCKETS + ((value >> shift) - HISTOGRAM_SUB_BUCKETS);
+    return min(i, (uint32_t) HISTOGRAM_BUCKETS - 1);
+}
+
+uint64_t Histogram::bucket_bound(uint32_t i){
+    if(i < HISTOGRAM_SUB_BUCKETS){
+        return i + 1;
+    }
+    uint32_t shift = i / HISTOGRAM_SUB_BUCKETS - 1;
+    return (uint64_t) (HISTOGRAM_SUB_BUCKETS + i % HISTOGRAM_SUB_BUCKETS + 1) << shift;
+}
+
+void Histogram::record(uint64_t value){
+    buckets[bucket_index(value)].fetch_add(1, memory_order_relaxed);
+    sum.fetch_add(value, memory_order_relaxed);
+}
+
+uint64_t Histogram::quantile(double q){
+    uint64_t counts[HISTOGRAM_BUCKETS];
+    uint64_t count = 0;
+    for(uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++){
+        counts[i] = buckets[i].load(memory_order_relaxed);
+        count += counts[i];
+    }
+
+    uint64_t seen = 0;
+    for(uint32_t i = 0; i < HISTOGRAM_BUCKETS && count != 0; i++){
+        seen += counts[i];
+        if(seen >= q * count){
+            return bucket_bound(i);
+        }
+    }
+    return 0;
+}
+
+void Histogram::render(ostringstream &out, const string &name, const string &labels, double scale){
+    string sep = labels.empty() ? "" : ",";
+    string braces = labels.empty() ? "" : "{" + labels + "}";
+
+    // the fine buckets are exported once per power of two up to HISTOGRAM_EXPORT_MAX,
+    // so that every scrape has the same bucket set
+    uint64_t count = 0;
+    for(uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++){
+        count += buckets[i].load(memory_order_relaxed);
+        uint64_t bound = bucket_bound(i);
+        if((bound & (bound - 1)) == 0 && bound <= HISTOGRAM_EXPORT_MAX){
+            out << name << "_bucket{" << labels << sep << "le=\"" << bound * scale << "\"} " << count << "\n";
+        }
+    }
+    out << name << "_bucket{" << labels << sep << "le=\"+Inf\"} " << count << "\n";
+    out << name << "_sum" << braces << " " << sum.load(memory_order_relaxed) * scale << "\n";
+    out << name << "_count" << braces << " " << count << "\n";
+}
+
+Metrics::Metrics(){
+    epochs = 0;
+    overruns = 0;
+    meter_updates = 0;
+    flag_digests = 0;
+    flag_digest_drops = 0;
+    flag_digest_skips = 0;
+    flag_scans = 0;
+    interval_seconds = 0;
+    monitored_addr = 0;
+    cur_active_addr = 0;
+    active_addr = 0;
+    inactive_addr = 0;
+    last_epoch_us = 0;
+}
+
+void Metrics::record_epoch(const EpochStats &stats){
+    epoch.record(stats.total_ms * 1000);
+    sync.record(stats.sync_ms * 1000);
+    read.record(stats.read_ms * 1000);
+    classify.record(stats.classify_ms * 1000);
+    global_write.record(stats.global_write_ms * 1000);
+    flag_reset.record(stats.flag_reset_ms * 1000);
+    meter_update.record(stats.meter_update_ms * 1000);
+
+    last_epoch_us = stats.total_ms * 1000;
+    epochs++;
+    if(stats.total_ms > interval_seconds * 1000.0){
+        overruns++;
+    }
+}
+
+static void family(ostringstream &out, const string &name, const string &type, const string &help){
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " " << type << "\n";
+}
+
+string Metrics::render(){
+    ostringstream out;
+
+    family(out, "telescope_epoch_seconds", "histogram", "Wall time of an epoch, including the meter update.");
+    epoch.render(out, "telescope_epoch_seconds", "", 1e-6);
+    // from the fine buckets, to compare with the interval without histogram_quantile
+    family(out, "telescope_epoch_quantile_seconds", "gauge", "Upper bound of the epoch wall time quantile.");
+    for(auto q: {"0.5", "0.9", "0.99"}){
+        out << "telescope_epoch_quantile_seconds{quantile=\"" << q << "\"} " << epoch.quantile(atof(q)) * 1e-6 << "\n";
+    }
+
+    family(out, "telescope_epoch_phase_seconds", "histogram",
+            "Time spent in each phase of an epoch, summed over banks and workers.");
+    sync.render(out, "telescope_epoch_phase_seconds", "phase=\"sync\"", 1e-6);
+    read.render(out, "telescope_epoch_phase_seconds", "phase=\"read\"", 1e-6);
+    classify.render(out, "telescope_epoch_phase_seconds", "phase=\"classify\"", 1e-6);
+    global_write.render(out, "telescope_epoch_phase_seconds", "phase=\"global_write\"", 1e-6);
+    flag_reset.render(out, "telescope_epoch_phase_seconds", "phase=\"flag_reset\"", 1e-6);
+    meter_update.render(out, "telescope_epoch_phase_seconds", "phase=\"meter_update\"", 1e-6);
+
+    family(out, "telescope_register_sync_seconds", "histogram", "Latency of one flag register sync.");
+    register_sync.render(out, "telescope_register_sync_seconds", "", 1e-6);
+
+    family(out, "telescope_register_write_batch_entries", "histogram", "Entries written per register batch.");
+    global_batch.render(out, "telescope_register_write_batch_entries", "table=\"global\"", 1);
+    flag_batch.render(out, "telescope_register_write_batch_entries", "table=\"flag\"", 1);
+
+    family(out, "telescope_epochs_total", "counter", "Epochs run.");
+    out << "telescope_epochs_total " << epochs << "\n";
+    family(out, "telescope_epoch_overruns_total", "counter", "Epochs that took longer than the interval.");
+    out << "telescope_epoch_overruns_total " << overruns << "\n";
+    family(out, "telescope_meter_updates_total", "counter", "dark_meter entries rewritten.");
+    out << "telescope_meter_updates_total " << meter_updates << "\n";
+    family(out, "telescope_flag_digests_total", "counter", "Flags learned from digests.");
+    out << "telescope_flag_digests_total " << flag_digests << "\n";
+    family(out, "telescope_flag_digest_drops_total", "counter", "Flag digests dropped because the queue was full.");
+    out << "telescope_flag_digest_drops_total " << flag_digest_drops << "\n";
+    family(out, "telescope_flag_digest_skips_total", "counter", "Flag digests skipped because a field could not be read.");
+    out << "telescope_flag_digest_skips_total " << flag_digest_skips << "\n";
+    family(out, "telescope_flag_scans_total", "counter", "Epochs that read every flag_table entry.");
+    out << "telescope_flag_scans_total " << flag_scans << "\n";
+
+    family(out, "telescope_epoch_interval_seconds", "gauge", "Configured time between epochs.");
+    out << "telescope_epoch_interval_seconds " << interval_seconds << "\n";
+    family(out, "telescope_last_epoch_seconds", "gauge", "Wall time of the last epoch.");
+    out << "telescope_last_epoch_seconds " << last_epoch_us * 1e-6 << "\n";
+    family(out, "telescope_monitored_addresses", "gauge", "Monitored addresses.");
+    out << "telescope_monitored_addresses " << monitored_addr << "\n";
+    family(out, "telescope_current_active_addresses", "gauge", "Addresses flagged in the last epoch.");
+    out << "telescope_current_active_addresses " << cur_active_addr << "\n";
+    family(out, "telescope_active_addresses", "gauge", "Addresses flagged within the last alpha epochs.");
+    out << "telescope_active_addresses " << active_addr << "\n";
+    family(out, "telescope_inactive_addresses", "gauge", "Addresses counted towards the dark meters in the last epoch.");
+    out << "telescope_inactive_addresses " << inactive_addr << "\n";
+
+    return out.str();
+}
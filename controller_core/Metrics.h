@@ -0,0 +1,102 @@
+#ifndef METRICS_H // Include guards to prevent multiple inclusion
+
+#define METRICS_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <sstream>
+
+// log-linear buckets: values below HISTOGRAM_SUB_BUCKETS get one bucket each,
+// every power of two above is split in HISTOGRAM_SUB_BUCKETS equal buckets
+#define HISTOGRAM_SUB_BUCKETS 4
+#define HISTOGRAM_BUCKETS (40 * HISTOGRAM_SUB_BUCKETS)
+// largest bucket bound exported, 2^32
+#define HISTOGRAM_EXPORT_MAX (1ULL << 32)
+
+using namespace std;
+
+// time spent in each phase of an epoch, in milliseconds; phases of
+// different banks and shards overlap, so their times are summed
+struct EpochStats {
+    double sync_ms;
+    double read_ms;
+    double classify_ms;
+    double global_write_ms;
+    double flag_reset_ms;
+    double meter_update_ms;
+    double total_ms;            // wall time of the epoch
+
+    void clear();
+
+    void add(const EpochStats &other);
+};
+
+/*
+ * HDR-style histogram of non-negative integer values with a bounded
+ * relative error. Recording is lock-free so the shard threads can share
+ * one histogram.
+ */
+class Histogram {
+    private:
+        atomic<uint64_t> buckets[HISTOGRAM_BUCKETS];
+        atomic<uint64_t> sum;
+
+        static uint32_t bucket_index(uint64_t value);
+    public:
+        Histogram();
+
+        void record(uint64_t value);
+
+        // values in bucket i are below bucket_bound(i)
+        static uint64_t bucket_bound(uint32_t i);
+
+        // smallest bucket bound with at least q of the values below it
+        uint64_t quantile(double q);
+
+        // Prometheus histogram samples, bounds and sum multiplied by scale
+        void render(ostringstream &out, const string &name, const string &labels, double scale);
+};
+
+/*
+ * Controller metrics, exported in the Prometheus text format. Latencies
+ * are recorded in microseconds and exported in seconds.
+ */
+class Metrics {
+    public:
+        Histogram epoch;
+        Histogram sync;
+        Histogram read;
+        Histogram classify;
+        Histogram global_write;
+        Histogram flag_reset;
+        Histogram meter_update;
+        // one sample per register sync (tableOperationsExecute until the callback)
+        Histogram register_sync;
+        // entries per Register::add_entries call
+        Histogram global_batch;
+        Histogram flag_batch;
+
+        atomic<uint64_t> epochs;
+        atomic<uint64_t> overruns;          // epochs longer than the interval
+        atomic<uint64_t> meter_updates;     // dark_meter entries rewritten
+        atomic<uint64_t> flag_digests;      // flags learned from digests
+        atomic<uint64_t> flag_digest_drops; // digests dropped because the queue was full
+        atomic<uint64_t> flag_digest_skips; // digests skipped because a field could not be read
+        atomic<uint64_t> flag_scans;        // epochs that read every flag_table entry
+        atomic<uint64_t> interval_seconds;
+        atomic<uint64_t> monitored_addr;
+        atomic<uint64_t> cur_active_addr;
+        atomic<uint64_t> active_addr;
+        atomic<uint64_t> inactive_addr;
+        atomic<uint64_t> last_epoch_us;
+
+        Metrics();
+
+        void record_epoch(const EpochStats &stats);
+
+        string render();
+};
+
+#endif // METRICS_H
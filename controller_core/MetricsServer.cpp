@@ -0,0 +1,137 @@
+#include "MetricsServer.h"
+
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <iostream>
+
+MetricsServer::MetricsServer(Metrics *metrics, uint16_t port, const string &socket_path){
+    this->metrics = metrics;
+    this->port = port;
+    this->socket_path = socket_path;
+}
+
+int MetricsServer::listen_tcp(){
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if(fd < 0 || bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0 || listen(fd, 16) < 0){
+        cerr << "Error: Could not listen for metrics on port " << port << ": " << strerror(errno) << endl;
+        exit(1);
+    }
+    return fd;
+}
+
+int MetricsServer::listen_unix(){
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if(socket_path.size() >= sizeof(addr.sun_path)){
+        cerr << "Error: Metrics socket path " << socket_path << " is too long" << endl;
+        exit(1);
+    }
+    strcpy(addr.sun_path, socket_path.c_str());
+    // left over by a previous run
+    unlink(socket_path.c_str());
+
+    if(fd < 0 || bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0 || listen(fd, 16) < 0){
+        cerr << "Error: Could not listen for metrics on " << socket_path << ": " << strerror(errno) << endl;
+        exit(1);
+    }
+    return fd;
+}
+
+void MetricsServer::handle(int fd){
+    // a stuck client must not block the next scrape for long
+    struct timeval timeout = {1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    string request;
+    char buf[1024];
+    while(request.find("\r\n\r\n") == string::npos && request.size() < 8192){
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if(n <= 0){
+            break;
+        }
+        request.append(buf, n);
+    }
+
+    string status = "200 OK";
+    string body;
+    if(request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 6, "GET / ") == 0){
+        body = metrics->render();
+    }
+    else{
+        status = "404 Not Found";
+        body = "metrics are served on /metrics\n";
+    }
+
+    string response = "HTTP/1.0 " + status + "\r\n"
+                        "Content-Type: text/plain; version=0.0.4\r\n"
+                        "Content-Length: " + to_string(body.size()) + "\r\n"
+                        "Connection: close\r\n\r\n" + body;
+
+    size_t sent = 0;
+    while(sent < response.size()){
+        ssize_t n = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if(n <= 0){
+            break;
+        }
+        sent += n;
+    }
+    close(fd);
+}
+
+void MetricsServer::serve(){
+    vector<struct pollfd> fds;
+    for(auto fd: listeners){
+        fds.push_back({fd, POLLIN, 0});
+    }
+
+    while(true){
+        if(poll(fds.data(), fds.size(), -1) < 0){
+            continue;
+        }
+        for(auto &pfd: fds){
+            if(pfd.revents & POLLIN){
+                int fd = accept(pfd.fd, nullptr, nullptr);
+                if(fd >= 0){
+                    handle(fd);
+                }
+            }
+        }
+    }
+}
+
+void MetricsServer::start(){
+    if(port != 0){
+        listeners.push_back(listen_tcp());
+        cout << "Metrics on http://127.0.0.1:" << port << "/metrics" << endl;
+    }
+    if(!socket_path.empty()){
+        listeners.push_back(listen_unix());
+        cout << "Metrics on " << socket_path << endl;
+    }
+    if(listeners.empty()){
+        return;
+    }
+
+    server = thread(&MetricsServer::serve, this);
+    server.detach();
+}
@@ -0,0 +1,41 @@
+#ifndef METRICSSERVER_H // Include guards to prevent multiple inclusion
+
+#define METRICSSERVER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <thread>
+
+#include "Metrics.h"
+
+using namespace std;
+
+/*
+ * Serves Metrics::render() to HTTP GET /metrics on 127.0.0.1:port and/or
+ * on a UNIX socket (curl --unix-socket path http://localhost/metrics).
+ * Requests are answered one at a time on a single thread.
+ */
+class MetricsServer {
+    private:
+        Metrics *metrics;
+        uint16_t port;
+        string socket_path;
+        vector<int> listeners;
+        thread server;
+
+        int listen_tcp();
+
+        int listen_unix();
+
+        void handle(int fd);
+
+        void serve();
+    public:
+        // port 0 or an empty socket_path leave that listener out
+        MetricsServer(Metrics *metrics, uint16_t port, const string &socket_path);
+
+        void start();
+};
+
+#endif // METRICSSERVER_H
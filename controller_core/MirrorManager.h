@@ -0,0 +1,18 @@
+#ifndef MIRRORMGR_H // Include guards to prevent multiple inclusion
+
+#define MIRRORMGR_H
+
+#include <stdint.h>
+
+using namespace std;
+
+class MirrorManager {
+    public:
+        virtual ~MirrorManager() {}
+
+        virtual void add_mirror_port(uint16_t sid, uint16_t port) = 0;
+
+        virtual void add_mirror_group(uint16_t sid, uint16_t grp_a, uint16_t grp_b, uint16_t pkt_len) = 0;
+};
+
+#endif // MIRRORMGR_H
\ No newline at end of file
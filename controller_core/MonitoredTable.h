@@ -0,0 +1,25 @@
+#ifndef MONITOREDTABLE_H // Include guards to prevent multiple inclusion
+
+#define MONITOREDTABLE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// LPM table mapping a monitored prefix to its register and dark_meter ranges
+class MonitoredTable{
+    public:
+        virtual ~MonitoredTable() {}
+
+        // prefix is the address in network byte order, 4 bytes for IPv4 and 16 for IPv6;
+        // dark_base_idx is dropped by programs without it
+        virtual void add_entry(const vector<uint8_t> &prefix,
+                                uint16_t length,
+                                uint32_t base_idx,
+                                uint32_t mask,
+                                uint32_t dark_base_idx) = 0;
+};
+
+#endif // MONITOREDTABLE_H
@@ -0,0 +1,17 @@
+#ifndef MULTICASTGROUP_H // Include guards to prevent multiple inclusion
+
+#define MULTICASTGROUP_H
+
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+
+class MulticastGroup{
+    public:
+        virtual ~MulticastGroup() {}
+
+        virtual void add_group(uint16_t group_id, vector<uint16_t> rids) = 0;
+};
+
+#endif // MULTICASTGROUP_H
\ No newline at end of file
@@ -0,0 +1,16 @@
+#ifndef NODE_H // Include guards to prevent multiple inclusion
+
+#define NODE_H
+
+#include <stdint.h>
+
+using namespace std;
+
+class Node {
+    public:
+        virtual ~Node() {}
+
+        virtual void add_node(uint16_t rid, uint16_t port) = 0;
+};
+
+#endif // NODE_H
\ No newline at end of file
@@ -0,0 +1,17 @@
+#ifndef PORTMGR_H // Include guards to prevent multiple inclusion
+
+#define PORTMGR_H
+
+#include <stdint.h>
+#include <string>
+
+using namespace std;
+
+class PortManager {
+    public:
+        virtual ~PortManager() {}
+
+        virtual void port_enable(const uint16_t &port, const string &speed) = 0;
+};
+
+#endif // PORTMGR_H
\ No newline at end of file
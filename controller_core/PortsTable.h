@@ -0,0 +1,17 @@
+#ifndef PORTSTABLE_H // Include guards to prevent multiple inclusion
+
+#define PORTSTABLE_H
+
+#include <stdint.h>
+
+using namespace std;
+
+class PortsTable{
+    public:
+        virtual ~PortsTable() {}
+
+        // direction is false for incoming and true for outgoing ports
+        virtual void add_entry(const uint16_t &port, bool direction) = 0;
+};
+
+#endif // PORTSTABLE_H
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include "PrefixMap.h"
+
+#include <stdio.h>
+#include <string.h>
+
+bool write_prefix_map(const string &path, const vector<PrefixMapRecord> &records){
+    string tmp_path = path + ".tmp";
+    FILE *file = fopen(tmp_path.c_str(), "wb");
+    if(!file){
+        return false;
+    }
+
+    PrefixMapHeader header;
+    memcpy(header.magic, PREFIX_MAP_MAGIC, sizeof(header.magic));
+    header.version = PREFIX_MAP_VERSION;
+    header.record_size = sizeof(PrefixMapRecord);
+    header.record_count = records.size();
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(records.data(), sizeof(PrefixMapRecord), records.size(), file) == records.size();
+    ok = fclose(file) == 0 && ok;
+    if(!ok || rename(tmp_path.c_str(), path.c_str()) != 0){
+        remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
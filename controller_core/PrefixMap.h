@@ -0,0 +1,44 @@
+#ifndef PREFIXMAP_H // Include guards to prevent multiple inclusion
+
+#define PREFIXMAP_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#define PREFIX_MAP_MAGIC "TPFX"
+#define PREFIX_MAP_VERSION 1
+
+using namespace std;
+
+// start of the file
+struct PrefixMapHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t record_count;
+};
+
+// a monitored prefix: its /unit_len blocks have indices base_idx, base_idx + 1, ...
+struct PrefixMapRecord {
+    uint8_t addr[16];       // network byte order, IPv4 in the first 4 bytes
+    uint32_t base_idx;
+    uint8_t family;         // 4 or 6
+    uint8_t prefix_len;
+    uint8_t unit_len;
+    uint8_t reserved;
+};
+
+/*
+ * Binary map of the monitored prefixes to address indices, read by the
+ * capture application (dpdk-buffer/prefix_map.h has the same layout).
+ * One record per prefix. The indices are those of the event log and the
+ * activity feed, banks * i + t for register index i of bank t, so each
+ * address (/unit_len block for IPv6) of a prefix gets the next index.
+ *
+ * The whole map is written to a temporary file first and renamed over
+ * path, so readers never see a partial map. Returns false on failure.
+ */
+bool write_prefix_map(const string &path, const vector<PrefixMapRecord> &records);
+
+#endif // PREFIXMAP_H
@@ -0,0 +1,188 @@
+#ifndef PROGRAMS_H // Include guards to prevent multiple inclusion
+
+#define PROGRAMS_H
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <string>
+
+using namespace std;
+
+/*
+ * Traits of the telescope programs the controller core is built for; the
+ * Makefile of each program picks one with -DPROGRAM=<name>.
+ *
+ * The data plane tracks one register index per unit: an IPv4 address or an
+ * IPv6 /56. The unit of an address is its first UNIT_LEN bits. The low
+ * BANK_BITS bits of the unit pick the bank (flag_table<bank> and
+ * global_table<bank>), and the bits above them are the offset of the unit
+ * within its monitored prefix. Register index i of bank t is then address
+ * index BANKS * i + t, as in the event log, the prefix map and the
+ * activity feed.
+ */
+
+// address family of the monitored prefixes
+struct IPv4 {
+    static constexpr int AF = AF_INET;
+    static constexpr uint8_t FAMILY = 4;
+    static constexpr uint32_t ADDR_BYTES = 4;
+    static constexpr uint32_t UNIT_LEN = 32;
+};
+
+struct IPv6 {
+    static constexpr int AF = AF_INET6;
+    static constexpr uint8_t FAMILY = 6;
+    static constexpr uint32_t ADDR_BYTES = 16;
+    static constexpr uint32_t UNIT_LEN = 56;
+};
+
+/*
+ * Program traits:
+ *  Family              address family, IPv4 or IPv6
+ *  TARGET              directory of the switchd conf file under share/p4/targets
+ *  NUM_PIPES           pipes of the device; one recirculation node each
+ *  RECIRCULATE_PORT    recirculation port of pipe 0
+ *  LOG_PORT            port of the capture host, see constants.p4
+ *  MIRROR_PKT_LEN      truncation length of the mirrored notifications
+ *  BANK_BITS           log2 of the number of register banks
+ *  HAS_METERS          whether the program rate limits with dark_meter and dark_global_meter
+ *  METER_SHIFT         dark_meter index the controller counts register index i under: i >> METER_SHIFT
+ *  DARK_IDX_SHIFT      dark_meter index the data plane uses: dark_base_idx + (offset >> DARK_IDX_SHIFT)
+ *  DARK_PREFIX_LEN     dark_meter indices a prefix of length l takes: 2^(DARK_PREFIX_LEN - l);
+ *                      0 if the controller leaves dark_base_idx at 0
+ *  RATES_FROM_EXPIRED  if set only the addresses that expired in an epoch count towards its rates,
+ *                      otherwise all inactive addresses do
+ *  GLOBAL_TABLE_SIZE   register entries per bank, GLOBAL_TABLE_ENTRIES in constants.p4
+ *  OUTGOING_PORT       default port towards the border routers
+ *  INCOMING_PORT       default port from the border routers
+ */
+template <class Program>
+struct ProgramIndex {
+    static constexpr uint32_t BANKS = 1U << Program::BANK_BITS;
+    // offset bits of the /0; a prefix of length l has 2^(OFFSET_LEN - l) register indices per bank
+    static constexpr uint32_t OFFSET_LEN = Program::Family::UNIT_LEN - Program::BANK_BITS;
+
+    // first UNIT_LEN bits of addr, given in network byte order
+    static inline uint64_t unit(const uint8_t *addr){
+        uint64_t unit = 0;
+        for(uint32_t i = 0; i < Program::Family::UNIT_LEN / 8; i++){
+            unit = (unit << 8) | addr[i];
+        }
+        return unit;
+    }
+
+    // inverse of unit(); the bits after the unit are cleared
+    static inline void unit_addr(uint64_t unit, uint8_t *addr){
+        memset(addr, 0, Program::Family::ADDR_BYTES);
+        for(uint32_t i = 0; i < Program::Family::UNIT_LEN / 8; i++){
+            addr[i] = unit >> (Program::Family::UNIT_LEN - 8 * (i + 1));
+        }
+    }
+
+    static inline uint32_t bank(uint64_t unit){
+        return unit & (BANKS - 1);
+    }
+
+    static inline uint32_t offset(uint64_t unit, uint32_t mask){
+        return (unit >> Program::BANK_BITS) & mask;
+    }
+
+    // register indices per bank of a prefix of length length, minus one
+    static inline uint32_t mask(uint32_t length){
+        return (1ULL << (OFFSET_LEN - length)) - 1;
+    }
+
+    // flag_table<bank> and global_table<bank>; a single bank has no suffix
+    static inline string register_name(const string &name, uint32_t bank){
+        if(BANKS == 1){
+            return "pipe.Ingress." + name;
+        }
+        return "pipe.Ingress." + name + to_string(bank);
+    }
+
+    // parses text into addr (ADDR_BYTES bytes, network byte order); false if it is not an address of the family
+    static inline bool parse(const string &text, uint8_t *addr){
+        return inet_pton(Program::Family::AF, text.c_str(), addr) == 1;
+    }
+};
+
+// tofino/ipv4: one bank of /32s
+struct TofinoIPv4 {
+    typedef IPv4 Family;
+    static constexpr const char *TARGET = "tofino";
+    static constexpr uint32_t NUM_PIPES = 2;
+    static constexpr uint16_t RECIRCULATE_PORT = 68;
+    static constexpr uint16_t LOG_PORT = 24;
+    static constexpr uint16_t MIRROR_PKT_LEN = 43;
+    static constexpr uint32_t BANK_BITS = 0;
+    static constexpr bool HAS_METERS = true;
+    static constexpr uint32_t METER_SHIFT = 8;
+    static constexpr uint32_t DARK_IDX_SHIFT = 8;
+    static constexpr uint32_t DARK_PREFIX_LEN = 24;
+    static constexpr bool RATES_FROM_EXPIRED = false;
+    static constexpr uint32_t GLOBAL_TABLE_SIZE = 4194304;
+    static constexpr uint16_t OUTGOING_PORT = 1;
+    static constexpr uint16_t INCOMING_PORT = 2;
+};
+
+// tofino/ipv6: four banks of /56s, no rate limiting
+struct TofinoIPv6 {
+    typedef IPv6 Family;
+    static constexpr const char *TARGET = "tofino";
+    static constexpr uint32_t NUM_PIPES = 2;
+    static constexpr uint16_t RECIRCULATE_PORT = 68;
+    static constexpr uint16_t LOG_PORT = 24;
+    static constexpr uint16_t MIRROR_PKT_LEN = 71;
+    static constexpr uint32_t BANK_BITS = 2;
+    static constexpr bool HAS_METERS = false;
+    // only sizes the per dark_meter counts of the aging, which go unused
+    static constexpr uint32_t METER_SHIFT = 8;
+    static constexpr uint32_t DARK_IDX_SHIFT = 0;
+    static constexpr uint32_t DARK_PREFIX_LEN = 0;
+    static constexpr bool RATES_FROM_EXPIRED = false;
+    static constexpr uint32_t GLOBAL_TABLE_SIZE = 4194304;
+    static constexpr uint16_t OUTGOING_PORT = 1;
+    static constexpr uint16_t INCOMING_PORT = 2;
+};
+
+// tofino2/ipv4: two banks of /32s
+struct Tofino2IPv4 {
+    typedef IPv4 Family;
+    static constexpr const char *TARGET = "tofino2";
+    static constexpr uint32_t NUM_PIPES = 2;
+    static constexpr uint16_t RECIRCULATE_PORT = 6;
+    static constexpr uint16_t LOG_PORT = 16;
+    static constexpr uint16_t MIRROR_PKT_LEN = 43;
+    static constexpr uint32_t BANK_BITS = 1;
+    static constexpr bool HAS_METERS = true;
+    static constexpr uint32_t METER_SHIFT = 8;
+    static constexpr uint32_t DARK_IDX_SHIFT = 7;
+    static constexpr uint32_t DARK_PREFIX_LEN = 24;
+    static constexpr bool RATES_FROM_EXPIRED = false;
+    static constexpr uint32_t GLOBAL_TABLE_SIZE = 2097152;
+    static constexpr uint16_t OUTGOING_PORT = 8;
+    static constexpr uint16_t INCOMING_PORT = 9;
+};
+
+// tofino2/ipv6: eight banks of /56s
+struct Tofino2IPv6 {
+    typedef IPv6 Family;
+    static constexpr const char *TARGET = "tofino2";
+    static constexpr uint32_t NUM_PIPES = 2;
+    static constexpr uint16_t RECIRCULATE_PORT = 6;
+    static constexpr uint16_t LOG_PORT = 16;
+    static constexpr uint16_t MIRROR_PKT_LEN = 73;
+    static constexpr uint32_t BANK_BITS = 3;
+    static constexpr bool HAS_METERS = true;
+    static constexpr uint32_t METER_SHIFT = 7;
+    static constexpr uint32_t DARK_IDX_SHIFT = 7;
+    static constexpr uint32_t DARK_PREFIX_LEN = 0;
+    static constexpr bool RATES_FROM_EXPIRED = true;
+    static constexpr uint32_t GLOBAL_TABLE_SIZE = 2097152;
+    static constexpr uint16_t OUTGOING_PORT = 8;
+    static constexpr uint16_t INCOMING_PORT = 9;
+};
+
+#endif // PROGRAMS_H
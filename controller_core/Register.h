@@ -0,0 +1,34 @@
+#ifndef REGISTER_H // Include guards to prevent multiple inclusion
+
+#define REGISTER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <mutex>
+
+// number of entries fetched per batched read
+#define REGISTER_READ_BATCH 4096
+
+using namespace std;
+
+// register array with one value per pipe; reads come from the software
+// shadow, which start_sync/end_sync refresh from the hardware
+class Register {
+    public:
+        virtual ~Register() {}
+
+        virtual vector<vector<uint64_t>> get_entries(const uint32_t start_idx, const uint32_t end_idx) = 0;
+
+        // bit (index - start_idx) is set if the entry is non-zero in any pipe
+        virtual void get_entries_bitmap(const uint32_t start_idx, const uint32_t end_idx, vector<uint64_t> &bitmap) = 0;
+
+        // writes all keys in one batch
+        virtual void add_entries(vector<uint32_t> keys, int value) = 0;
+
+        virtual unique_lock<mutex> start_sync() = 0;
+
+        virtual void end_sync(unique_lock<mutex> &lck) = 0;
+};
+
+#endif // REGISTER_H
\ No newline at end of file
@@ -0,0 +1,405 @@
+#include "SimSwitch.h"
+
+#include <cassert>
+
+SimSession::SimSession(SimSwitch *sw){
+    this->sw = sw;
+    in_batch = false;
+}
+
+void SimSession::begin_batch(){
+    in_batch = true;
+}
+
+// one driver call commits the whole batch
+void SimSession::end_batch(){
+    sw->charge(sw->costs.call_ns + (uint64_t) sw->costs.entry_ns * pending.size());
+    {
+        lock_guard<mutex> lck(sw->state_lock);
+        for(auto &op: pending){
+            op();
+        }
+    }
+    pending.clear();
+    in_batch = false;
+}
+
+void SimSession::write(function<void()> op){
+    if(in_batch){
+        pending.push_back(op);
+        return;
+    }
+    sw->charge(sw->costs.call_ns + sw->costs.entry_ns);
+    lock_guard<mutex> lck(sw->state_lock);
+    op();
+}
+
+SimSwitch::SimSwitch(uint32_t num_pipes, uint32_t register_size, uint32_t meter_size, SimCosts costs){
+    this->num_pipes = num_pipes;
+    this->register_size = register_size;
+    this->meter_size = meter_size;
+    this->costs = costs;
+}
+
+uint32_t SimSwitch::pipes(){
+    return num_pipes;
+}
+
+void SimSwitch::charge(uint64_t ns){
+    if(ns == 0){
+        return;
+    }
+    auto until = chrono::steady_clock::now() + chrono::nanoseconds(ns);
+    if(ns >= 1000000){
+        this_thread::sleep_until(until);
+        return;
+    }
+    while(chrono::steady_clock::now() < until);
+}
+
+// registers and meters are created with their first table object
+SimRegisterState *SimSwitch::register_state(const string &name){
+    lock_guard<mutex> lck(state_lock);
+    auto it = registers.find(name);
+    if(it != registers.end()){
+        return it->second;
+    }
+
+    SimRegisterState *state = new SimRegisterState;
+    state->size = register_size;
+    state->hw.assign(num_pipes, vector<uint8_t>(register_size, 0));
+    state->sw.assign(num_pipes, vector<uint8_t>(register_size, 0));
+    registers[name] = state;
+    return state;
+}
+
+vector<SimMeterEntry> *SimSwitch::meter_state(const string &name){
+    lock_guard<mutex> lck(state_lock);
+    auto it = meters.find(name);
+    if(it != meters.end()){
+        return it->second;
+    }
+
+    vector<SimMeterEntry> *state = new vector<SimMeterEntry>(meter_size, {0, 0, 0, 0, 0, 0, chrono::steady_clock::now()});
+    meters[name] = state;
+    return state;
+}
+
+uint8_t SimSwitch::meter_execute(vector<SimMeterEntry> *meter, uint32_t idx){
+    SimMeterEntry &entry = (*meter)[idx];
+    auto now = chrono::steady_clock::now();
+    double elapsed = chrono::duration<double>(now - entry.last).count();
+    entry.last = now;
+
+    entry.committed = min((double) entry.cbs_pkts, entry.committed + elapsed * entry.cir_pps);
+    entry.peak = min((double) entry.pbs_pkts, entry.peak + elapsed * entry.pir_pps);
+
+    if(entry.peak < 1){
+        return 3;
+    }
+    entry.peak -= 1;
+    if(entry.committed < 1){
+        return 1;
+    }
+    entry.committed -= 1;
+    return 0;
+}
+
+string SimSwitch::lpm_key(const uint8_t *addr, uint32_t addr_bytes, uint8_t length){
+    string key((const char *) addr, addr_bytes);
+    for(uint32_t i = 0; i < key.size(); i++){
+        if(length >= 8 * (i + 1)){
+            continue;
+        }
+        uint32_t keep = (length > 8 * i) ? length - 8 * i : 0;
+        key[i] &= (char) (keep == 0 ? 0 : 0xFF << (8 - keep));
+    }
+    return key;
+}
+
+const SimLpmEntry *SimSwitch::lookup(const uint8_t *addr, uint32_t addr_bytes){
+    for(auto &level: monitored){
+        auto it = level.second.find(lpm_key(addr, addr_bytes, level.first));
+        if(it != level.second.end()){
+            return &it->second;
+        }
+    }
+    return nullptr;
+}
+
+shared_ptr<BackendSession> SimSwitch::session_create(){
+    return make_shared<SimSession>(this);
+}
+
+Register *SimSwitch::new_register(const string &name, shared_ptr<BackendSession> session){
+    return new SimRegister(this, static_pointer_cast<SimSession>(session), register_state(name));
+}
+
+Meter *SimSwitch::new_meter(const string &name, shared_ptr<BackendSession> session){
+    return new SimMeter(this, static_pointer_cast<SimSession>(session), meter_state(name));
+}
+
+MonitoredTable *SimSwitch::new_monitored_table(shared_ptr<BackendSession> session){
+    return new SimMonitoredTable(this, static_pointer_cast<SimSession>(session));
+}
+
+ForwardTable *SimSwitch::new_forward_table(shared_ptr<BackendSession> session){
+    return new SimForwardTable(this, static_pointer_cast<SimSession>(session));
+}
+
+PortsTable *SimSwitch::new_ports_table(shared_ptr<BackendSession> session){
+    return new SimPortsTable(this, static_pointer_cast<SimSession>(session));
+}
+
+MirrorManager *SimSwitch::new_mirror_manager(shared_ptr<BackendSession> session){
+    return new SimMirrorManager(this, static_pointer_cast<SimSession>(session));
+}
+
+Node *SimSwitch::new_node(shared_ptr<BackendSession> session){
+    return new SimNode(this, static_pointer_cast<SimSession>(session));
+}
+
+MulticastGroup *SimSwitch::new_multicast_group(shared_ptr<BackendSession> session){
+    return new SimMulticastGroup(this, static_pointer_cast<SimSession>(session));
+}
+
+PortManager *SimSwitch::new_port_manager(shared_ptr<BackendSession> session){
+    return new SimPortManager(this, static_pointer_cast<SimSession>(session));
+}
+
+FlagDigest *SimSwitch::new_flag_digest(shared_ptr<BackendSession> session){
+    return new SimFlagDigest(this, static_pointer_cast<SimSession>(session));
+}
+
+SimRegister::SimRegister(SimSwitch *sw, shared_ptr<SimSession> session, SimRegisterState *state){
+    this->sw = sw;
+    this->session = session;
+    this->state = state;
+    sync_done = false;
+}
+
+SimRegister::~SimRegister(){
+    if(sync_thread.joinable()){
+        sync_thread.join();
+    }
+}
+
+// copy hw to sw in the background and signal like the sync callback
+unique_lock<mutex> SimRegister::start_sync(){
+    if(sync_thread.joinable()){
+        sync_thread.join();
+    }
+    unique_lock<mutex> lck(sync_lock);
+    sync_done = false;
+
+    sync_thread = thread([this](){
+        sw->charge(sw->costs.call_ns + (uint64_t) sw->costs.sync_entry_ns * state->size);
+        {
+            lock_guard<mutex> state_lck(sw->state_lock);
+            state->sw = state->hw;
+        }
+        lock_guard<mutex> sync_lck(sync_lock);
+        sync_done = true;
+        sync_completed.notify_all();
+    });
+
+    return lck;
+}
+
+void SimRegister::end_sync(unique_lock<mutex> &lck){
+    sync_completed.wait(lck, [this](){ return sync_done; });
+    lck.unlock();
+}
+
+vector<vector<uint64_t>> SimRegister::get_entries(const uint32_t start_idx, const uint32_t end_idx){
+    vector<vector<uint64_t>> output;
+    output.reserve(end_idx - start_idx + 1);
+
+    for(uint32_t index = start_idx; index < end_idx + 1; index++){
+        sw->charge(sw->costs.call_ns + sw->costs.entry_ns);
+
+        lock_guard<mutex> lck(sw->state_lock);
+        vector<uint64_t> temp_val;
+        for(auto &pipe: state->sw){
+            temp_val.push_back(pipe[index]);
+        }
+        output.push_back(temp_val);
+    }
+    return output;
+}
+
+// one driver call per REGISTER_READ_BATCH entries, as with tableEntryGetNext_n
+void SimRegister::get_entries_bitmap(const uint32_t start_idx, const uint32_t end_idx, vector<uint64_t> &bitmap){
+    uint32_t total = end_idx - start_idx + 1;
+    // empty range (end_idx == start_idx - 1): nothing to read
+    if(end_idx < start_idx || total == 0){
+        bitmap.clear();
+        return;
+    }
+    bitmap.assign((total + 63) / 64, 0);
+
+    for(uint32_t first = 0; first < total; first += REGISTER_READ_BATCH){
+        uint32_t n = min(total - first, (uint32_t) REGISTER_READ_BATCH);
+        sw->charge(sw->costs.call_ns + (uint64_t) sw->costs.entry_ns * n);
+
+        lock_guard<mutex> lck(sw->state_lock);
+        for(uint32_t offset = first; offset < first + n; offset++){
+            for(auto &pipe: state->sw){
+                if(pipe[start_idx + offset] != 0){
+                    bitmap[offset / 64] |= 1ULL << (offset % 64);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// entry adds write both copies in every pipe
+void SimRegister::add_entries(vector<uint32_t> keys, int value){
+    session->begin_batch();
+    for(auto index: keys){
+        assert(index < state->size);
+        session->write([this, index, value](){
+            for(uint32_t pipe = 0; pipe < sw->pipes(); pipe++){
+                state->hw[pipe][index] = value;
+                state->sw[pipe][index] = value;
+            }
+        });
+    }
+    session->end_batch();
+}
+
+SimMeter::SimMeter(SimSwitch *sw, shared_ptr<SimSession> session, vector<SimMeterEntry> *state){
+    this->sw = sw;
+    this->session = session;
+    this->state = state;
+}
+
+void SimMeter::add_entry(const uint32_t &avg_pkt_rate, const uint32_t &max_pkt_rate, const uint32_t &idx){
+    assert(idx < state->size());
+    uint64_t cir = avg_pkt_rate, pir = max_pkt_rate;
+    session->write([this, cir, pir, idx](){
+        SimMeterEntry &entry = (*state)[idx];
+        entry.cir_pps = cir;
+        entry.pir_pps = pir;
+        entry.cbs_pkts = 100;
+        entry.pbs_pkts = 100;
+        entry.committed = entry.cbs_pkts;
+        entry.peak = entry.pbs_pkts;
+        entry.last = chrono::steady_clock::now();
+    });
+}
+
+void SimMeter::add_entries(const vector<MeterEntry> &entries){
+    session->begin_batch();
+    for(auto &entry: entries){
+        add_entry(entry.avg_pkt_rate, entry.max_pkt_rate, entry.idx);
+    }
+    session->end_batch();
+}
+
+SimMonitoredTable::SimMonitoredTable(SimSwitch *sw, shared_ptr<SimSession> session){
+    this->sw = sw;
+    this->session = session;
+}
+
+void SimMonitoredTable::add_entry(const vector<uint8_t> &prefix, uint16_t length, uint32_t base_idx, uint32_t mask,
+                                    uint32_t dark_base_idx){
+    uint8_t fixed_length = (uint8_t) length;
+    string fixed_prefix = SimSwitch::lpm_key(prefix.data(), prefix.size(), fixed_length);
+    SimLpmEntry entry = {base_idx, mask, dark_base_idx};
+
+    session->write([this, fixed_length, fixed_prefix, entry](){
+        sw->monitored[fixed_length][fixed_prefix] = entry;
+    });
+}
+
+SimForwardTable::SimForwardTable(SimSwitch *sw, shared_ptr<SimSession> session){
+    this->sw = sw;
+    this->session = session;
+}
+
+void SimForwardTable::add_entry(const uint16_t &ingress_port, const uint16_t &egress_port){
+    uint16_t ingress = ingress_port, egress = egress_port;
+    session->write([this, ingress, egress](){
+        sw->forward[ingress] = egress;
+    });
+}
+
+SimPortsTable::SimPortsTable(SimSwitch *sw, shared_ptr<SimSession> session){
+    this->sw = sw;
+    this->session = session;
+}
+
+void SimPortsTable::add_entry(const uint16_t &port, bool direction){
+    uint16_t p = port;
+    session->write([this, p, direction](){
+        sw->port_directions[p] = direction;
+    });
+}
+
+SimMirrorManager::SimMirrorManager(SimSwitch *sw, shared_ptr<SimSession> session){
+    this->sw = sw;
+    this->session = session;
+}
+
+void SimMirrorManager::add_mirror_port(uint16_t sid, uint16_t port){
+    session->write([this, sid, port](){
+        sw->mirror_ports[sid] = port;
+    });
+}
+
+void SimMirrorManager::add_mirror_group(uint16_t sid, uint16_t grp_a, uint16_t grp_b, uint16_t pkt_len){
+    session->write([this, sid, grp_a, grp_b, pkt_len](){
+        sw->mirror_groups[sid] = {grp_a, grp_b, pkt_len};
+    });
+}
+
+SimNode::SimNode(SimSwitch *sw, shared_ptr<SimSession> session){
+    this->sw = sw;
+    this->session = session;
+}
+
+void SimNode::add_node(uint16_t rid, uint16_t port){
+    session->write([this, rid, port](){
+        sw->nodes[rid] = port;
+    });
+}
+
+SimMulticastGroup::SimMulticastGroup(SimSwitch *sw, shared_ptr<SimSession> session){
+    this->sw = sw;
+    this->session = session;
+}
+
+void SimMulticastGroup::add_group(uint16_t group_id, vector<uint16_t> rids){
+    session->write([this, group_id, rids](){
+        sw->groups[group_id] = rids;
+    });
+}
+
+SimPortManager::SimPortManager(SimSwitch *sw, shared_ptr<SimSession> session){
+    this->sw = sw;
+    this->session = session;
+}
+
+void SimPortManager::port_enable(const uint16_t &port, const string &speed){
+    uint16_t p = port;
+    session->write([this, p, speed](){
+        sw->port_speeds[p] = speed;
+    });
+}
+
+SimFlagDigest::SimFlagDigest(SimSwitch *sw, shared_ptr<SimSession> session){
+    this->sw = sw;
+    this->session = session;
+}
+
+void SimFlagDigest::subscribe(FlagDigestCallback callback){
+    lock_guard<mutex> lck(sw->state_lock);
+    sw->flag_digest = callback;
+}
+
+// the simulator builds its digests from the index, they are always valid
+uint64_t SimFlagDigest::take_skipped(){
+    return 0;
+}
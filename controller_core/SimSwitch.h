@@ -0,0 +1,330 @@
+#ifndef SIMSWITCH_H // Include guards to prevent multiple inclusion
+
+#define SIMSWITCH_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+
+#include "Backend.h"
+#include "Programs.h"
+
+using namespace std;
+
+// time charged for each simulated driver operation, in nanoseconds
+struct SimCosts {
+    uint32_t call_ns = 2000;        // one driver call: unbatched write, batch commit, batched read
+    uint32_t entry_ns = 40;         // each entry moved by a call
+    uint32_t sync_entry_ns = 2;     // each register index copied by a sync
+};
+
+// register array; the data plane writes hw, the controller reads sw
+struct SimRegisterState {
+    uint32_t size;
+    vector<vector<uint8_t>> hw;     // per pipe
+    vector<vector<uint8_t>> sw;     // per pipe, refreshed by syncs
+};
+
+struct SimMeterEntry {
+    uint64_t cir_pps, pir_pps, cbs_pkts, pbs_pkts;
+    // token buckets of the two-rate meter
+    double committed, peak;
+    chrono::steady_clock::time_point last;
+};
+
+struct SimLpmEntry {
+    uint32_t base_idx;
+    uint32_t mask;
+    uint32_t dark_base_idx;
+};
+
+class SimSwitch;
+
+// writes issued between begin_batch and end_batch are applied together
+class SimSession : public BackendSession {
+    private:
+        SimSwitch *sw;
+        bool in_batch;
+        vector<function<void()>> pending;
+    public:
+        SimSession(SimSwitch *sw);
+
+        void begin_batch();
+
+        void end_batch();
+
+        // applied right away outside of a batch
+        void write(function<void()> op);
+};
+
+/*
+ * In-memory switch running the telescope tables.
+ *
+ * Registers keep a hardware and a software copy per pipe: packets update
+ * the hardware copy, syncs copy it to the software copy in the background
+ * and reads only see the software copy, as with REGISTER_SYNC and
+ * GET_FROM_SW. Every driver operation is charged its SimCosts time, so
+ * batched and unbatched access keep their relative cost.
+ */
+class SimSwitch : public Backend {
+    private:
+        uint32_t num_pipes;
+        uint32_t register_size;
+        uint32_t meter_size;
+
+        map<string, SimRegisterState *> registers;
+        map<string, vector<SimMeterEntry> *> meters;
+    public:
+        SimCosts costs;
+        // guards all table state
+        mutex state_lock;
+
+        // LPM table per prefix length, longest first; keys are the masked address bytes
+        map<uint8_t, unordered_map<string, SimLpmEntry>, greater<uint8_t>> monitored;
+        unordered_map<uint16_t, uint16_t> forward;
+        unordered_map<uint16_t, bool> port_directions;
+        unordered_map<uint16_t, uint16_t> mirror_ports;
+        unordered_map<uint16_t, vector<uint16_t>> mirror_groups;
+        unordered_map<uint16_t, uint16_t> nodes;
+        unordered_map<uint16_t, vector<uint16_t>> groups;
+        unordered_map<uint16_t, string> port_speeds;
+        // subscriber of the flag digests, empty until one subscribes
+        FlagDigestCallback flag_digest;
+
+        SimSwitch(uint32_t num_pipes, uint32_t register_size, uint32_t meter_size, SimCosts costs = SimCosts());
+
+        uint32_t pipes();
+
+        // busy wait for short costs so that they are not rounded up by the scheduler
+        void charge(uint64_t ns);
+
+        SimRegisterState *register_state(const string &name);
+
+        vector<SimMeterEntry> *meter_state(const string &name);
+
+        // color of a packet through meter entry idx: 0 green, 1 yellow, 3 red
+        uint8_t meter_execute(vector<SimMeterEntry> *meter, uint32_t idx);
+
+        // the first addr_bytes bytes of addr with all bits after the first length bits cleared
+        static string lpm_key(const uint8_t *addr, uint32_t addr_bytes, uint8_t length);
+
+        const SimLpmEntry *lookup(const uint8_t *addr, uint32_t addr_bytes);
+
+        // outgoing packet from addr (network byte order): marks addr active; true if a notification would be mirrored
+        template <class Program>
+        bool packet_out(const uint8_t *addr, uint32_t pipe);
+
+        // incoming packet to addr (network byte order): true if it would be mirrored to the capture host
+        template <class Program>
+        bool packet_in(const uint8_t *addr, uint32_t pipe);
+
+        shared_ptr<BackendSession> session_create();
+
+        Register *new_register(const string &name, shared_ptr<BackendSession> session);
+
+        Meter *new_meter(const string &name, shared_ptr<BackendSession> session);
+
+        MonitoredTable *new_monitored_table(shared_ptr<BackendSession> session);
+
+        ForwardTable *new_forward_table(shared_ptr<BackendSession> session);
+
+        PortsTable *new_ports_table(shared_ptr<BackendSession> session);
+
+        MirrorManager *new_mirror_manager(shared_ptr<BackendSession> session);
+
+        Node *new_node(shared_ptr<BackendSession> session);
+
+        MulticastGroup *new_multicast_group(shared_ptr<BackendSession> session);
+
+        PortManager *new_port_manager(shared_ptr<BackendSession> session);
+
+        FlagDigest *new_flag_digest(shared_ptr<BackendSession> session);
+};
+
+class SimRegister : public Register {
+    private:
+        SimSwitch *sw;
+        shared_ptr<SimSession> session;
+        SimRegisterState *state;
+
+        // sync runs on its own thread and signals completion like the driver callback
+        mutex sync_lock;
+        condition_variable sync_completed;
+        bool sync_done;
+        thread sync_thread;
+    public:
+        SimRegister(SimSwitch *sw, shared_ptr<SimSession> session, SimRegisterState *state);
+
+        ~SimRegister();
+
+        vector<vector<uint64_t>> get_entries(const uint32_t start_idx, const uint32_t end_idx);
+
+        void get_entries_bitmap(const uint32_t start_idx, const uint32_t end_idx, vector<uint64_t> &bitmap);
+
+        void add_entries(vector<uint32_t> keys, int value);
+
+        unique_lock<mutex> start_sync();
+
+        void end_sync(unique_lock<mutex> &lck);
+};
+
+class SimMeter : public Meter {
+    private:
+        SimSwitch *sw;
+        shared_ptr<SimSession> session;
+        vector<SimMeterEntry> *state;
+    public:
+        SimMeter(SimSwitch *sw, shared_ptr<SimSession> session, vector<SimMeterEntry> *state);
+
+        void add_entry(const uint32_t &avg_pkt_rate, const uint32_t &max_pkt_rate, const uint32_t &idx);
+
+        void add_entries(const vector<MeterEntry> &entries);
+};
+
+class SimMonitoredTable : public MonitoredTable {
+    private:
+        SimSwitch *sw;
+        shared_ptr<SimSession> session;
+    public:
+        SimMonitoredTable(SimSwitch *sw, shared_ptr<SimSession> session);
+
+        void add_entry(const vector<uint8_t> &prefix, uint16_t length, uint32_t base_idx, uint32_t mask,
+                        uint32_t dark_base_idx);
+};
+
+class SimForwardTable : public ForwardTable {
+    private:
+        SimSwitch *sw;
+        shared_ptr<SimSession> session;
+    public:
+        SimForwardTable(SimSwitch *sw, shared_ptr<SimSession> session);
+
+        void add_entry(const uint16_t &ingress_port, const uint16_t &egress_port);
+};
+
+class SimPortsTable : public PortsTable {
+    private:
+        SimSwitch *sw;
+        shared_ptr<SimSession> session;
+    public:
+        SimPortsTable(SimSwitch *sw, shared_ptr<SimSession> session);
+
+        void add_entry(const uint16_t &port, bool direction);
+};
+
+class SimMirrorManager : public MirrorManager {
+    private:
+        SimSwitch *sw;
+        shared_ptr<SimSession> session;
+    public:
+        SimMirrorManager(SimSwitch *sw, shared_ptr<SimSession> session);
+
+        void add_mirror_port(uint16_t sid, uint16_t port);
+
+        void add_mirror_group(uint16_t sid, uint16_t grp_a, uint16_t grp_b, uint16_t pkt_len);
+};
+
+class SimNode : public Node {
+    private:
+        SimSwitch *sw;
+        shared_ptr<SimSession> session;
+    public:
+        SimNode(SimSwitch *sw, shared_ptr<SimSession> session);
+
+        void add_node(uint16_t rid, uint16_t port);
+};
+
+class SimMulticastGroup : public MulticastGroup {
+    private:
+        SimSwitch *sw;
+        shared_ptr<SimSession> session;
+    public:
+        SimMulticastGroup(SimSwitch *sw, shared_ptr<SimSession> session);
+
+        void add_group(uint16_t group_id, vector<uint16_t> rids);
+};
+
+class SimPortManager : public PortManager {
+    private:
+        SimSwitch *sw;
+        shared_ptr<SimSession> session;
+    public:
+        SimPortManager(SimSwitch *sw, shared_ptr<SimSession> session);
+
+        void port_enable(const uint16_t &port, const string &speed);
+};
+
+// digests are delivered on the thread of the packet that set the flag, one per message
+class SimFlagDigest : public FlagDigest {
+    private:
+        SimSwitch *sw;
+        shared_ptr<SimSession> session;
+    public:
+        SimFlagDigest(SimSwitch *sw, shared_ptr<SimSession> session);
+
+        void subscribe(FlagDigestCallback callback);
+
+        uint64_t take_skipped();
+};
+
+// same index computation as the ingress of telescope.p4
+template <class Program>
+bool SimSwitch::packet_out(const uint8_t *addr, uint32_t pipe){
+    typedef ProgramIndex<Program> Index;
+    uint64_t unit = Index::unit(addr);
+    SimRegisterState *global_table = register_state(Index::register_name("global_table", Index::bank(unit)));
+    SimRegisterState *flag_table = register_state(Index::register_name("flag_table", Index::bank(unit)));
+
+    lock_guard<mutex> lck(state_lock);
+    const SimLpmEntry *entry = lookup(addr, Program::Family::ADDR_BYTES);
+    if(entry == nullptr){
+        return false;
+    }
+    uint32_t idx = entry->base_idx + Index::offset(unit, entry->mask);
+
+    global_table->hw[pipe][idx] = 1;
+    bool notify = flag_table->hw[pipe][idx] == 0;
+    flag_table->hw[pipe][idx] = 1;
+    if(notify && flag_digest){
+        flag_digest(vector<FlagEvent>{{idx, Index::bank(unit)}});
+    }
+    return notify;
+}
+
+template <class Program>
+bool SimSwitch::packet_in(const uint8_t *addr, uint32_t pipe){
+    typedef ProgramIndex<Program> Index;
+    uint64_t unit = Index::unit(addr);
+    SimRegisterState *global_table = register_state(Index::register_name("global_table", Index::bank(unit)));
+    SimRegisterState *flag_table = register_state(Index::register_name("flag_table", Index::bank(unit)));
+    vector<SimMeterEntry> *dark_global_meter = meter_state("pipe.Ingress.dark_global_meter");
+    vector<SimMeterEntry> *dark_meter = meter_state("pipe.Ingress.dark_meter");
+
+    lock_guard<mutex> lck(state_lock);
+    const SimLpmEntry *entry = lookup(addr, Program::Family::ADDR_BYTES);
+    if(entry == nullptr){
+        return false;
+    }
+    uint32_t offset = Index::offset(unit, entry->mask);
+    uint32_t idx = entry->base_idx + offset;
+
+    if(global_table->hw[pipe][idx] != 0 || flag_table->hw[pipe][idx] != 0){
+        return false;
+    }
+    if(!Program::HAS_METERS){
+        return true;
+    }
+    uint8_t global_color = meter_execute(dark_global_meter, 0);
+    uint8_t color = meter_execute(dark_meter, entry->dark_base_idx + (offset >> Program::DARK_IDX_SHIFT));
+    return global_color == 0 && color == 0;
+}
+
+#endif // SIMSWITCH_H
@@ -0,0 +1,420 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "SimSwitch.h"
+#include "LocalClient.h"
+
+/*
+ * Epoch latency benchmark: runs the controller epochs against SimSwitch
+ * with a synthetic active population inside one monitored prefix and
+ * reports the time spent in each phase and the memory high-water mark.
+ *
+ * Every epoch a churn fraction of the active addresses is replaced by
+ * addresses that were not active, then every active address sends one
+ * outgoing packet before the epoch runs. With --learn the flags come from
+ * the digests of these packets instead of a flag_table read.
+ *
+ * IPv6 addresses are /56 subnets, so a /34 to /48 has as many addresses as
+ * an IPv4 /10 to /24.
+ *
+ * With --check, a single-worker controller runs the same epochs on a second
+ * switch, and both switches must end every epoch with the same global_table
+ * and dark_meter entries; the bench fails otherwise.
+ */
+
+#define OPT_PREFIX_LEN 0
+#define OPT_DENSITY 1
+#define OPT_CHURN 2
+#define OPT_EPOCHS 3
+#define OPT_WARMUP 4
+#define OPT_ALPHA 5
+#define OPT_AGING 6
+#define OPT_WORKERS 7
+#define OPT_CALL_NS 8
+#define OPT_ENTRY_NS 9
+#define OPT_SYNC_ENTRY_NS 10
+#define OPT_SEED 11
+#define OPT_VERBOSE 12
+#define OPT_EVENT_LOG 13
+#define OPT_EVENT_LOG_LEVEL 14
+#define OPT_LEARN 15
+#define OPT_RECONCILE_EVERY 16
+#define OPT_CHECK 17
+
+using namespace std;
+
+typedef ProgramIndex<PROGRAM> Index;
+
+// prefix lengths of 2^8 to 2^22 units
+#define MIN_PREFIX_LEN (PROGRAM::Family::UNIT_LEN - 22)
+#define MAX_PREFIX_LEN (PROGRAM::Family::UNIT_LEN - 8)
+
+// 10.0.0.0 or 2001:db8::
+static const char *base_prefix = (PROGRAM::Family::FAMILY == 4) ? "10.0.0.0" : "2001:db8::";
+
+struct BenchArgs {
+    uint32_t prefix_len = PROGRAM::Family::UNIT_LEN - 16;
+    double density = 0.01;      // fraction of the prefix active in every epoch
+    double churn = 0.1;         // fraction of the active addresses replaced every epoch
+    uint32_t epochs = 50;
+    uint32_t warmup = 2;        // first epochs left out of the report
+    uint16_t alpha = 3;
+    string aging = "wheel";
+    uint16_t workers = 1;
+    SimCosts costs;
+    uint32_t seed = 1;
+    bool verbose = false;
+    string event_log_path = "";
+    EventLevel event_log_level = EVENT_LEVEL_FLAGS;
+    bool learn = false;
+    uint32_t reconcile_every = 16;
+    bool check = false;         // compare the shards with one worker
+};
+
+BenchArgs* parse_bench_options(int argc, char **argv){
+    int option_index = 0;
+    BenchArgs* args = new BenchArgs;
+
+    static struct option options[] = {
+        {"prefix-len", required_argument, 0, OPT_PREFIX_LEN},
+        {"density", required_argument, 0, OPT_DENSITY},
+        {"churn", required_argument, 0, OPT_CHURN},
+        {"epochs", required_argument, 0, OPT_EPOCHS},
+        {"warmup", required_argument, 0, OPT_WARMUP},
+        {"alpha", required_argument, 0, OPT_ALPHA},
+        {"aging", required_argument, 0, OPT_AGING},
+        {"workers", required_argument, 0, OPT_WORKERS},
+        {"call-ns", required_argument, 0, OPT_CALL_NS},
+        {"entry-ns", required_argument, 0, OPT_ENTRY_NS},
+        {"sync-entry-ns", required_argument, 0, OPT_SYNC_ENTRY_NS},
+        {"seed", required_argument, 0, OPT_SEED},
+        {"verbose", no_argument, 0, OPT_VERBOSE},
+        {"event-log", required_argument, 0, OPT_EVENT_LOG},
+        {"event-log-level", required_argument, 0, OPT_EVENT_LOG_LEVEL},
+        {"learn", no_argument, 0, OPT_LEARN},
+        {"reconcile-every", required_argument, 0, OPT_RECONCILE_EVERY},
+        {"check", no_argument, 0, OPT_CHECK},
+        {NULL, 0, 0, 0}
+    };
+
+    while(1){
+        int opt = getopt_long(argc, argv, "", options, &option_index);
+
+        if(opt == -1){
+            break;
+        }
+
+        switch(opt){
+            case OPT_PREFIX_LEN:
+                args->prefix_len = atoi(optarg);
+                if (args->prefix_len < MIN_PREFIX_LEN || args->prefix_len > MAX_PREFIX_LEN) {
+                    printf("Invalid prefix length %s, expected %u to %u\n", optarg, MIN_PREFIX_LEN, MAX_PREFIX_LEN);
+                    exit(1);
+                }
+                break;
+            case OPT_DENSITY:
+                args->density = atof(optarg);
+                if (args->density < 0 || args->density > 1) {
+                    printf("Invalid density %s, expected 0 to 1\n", optarg);
+                    exit(1);
+                }
+                break;
+            case OPT_CHURN:
+                args->churn = atof(optarg);
+                if (args->churn < 0 || args->churn > 1) {
+                    printf("Invalid churn %s, expected 0 to 1\n", optarg);
+                    exit(1);
+                }
+                break;
+            case OPT_EPOCHS:
+                args->epochs = atoi(optarg);
+                break;
+            case OPT_WARMUP:
+                args->warmup = atoi(optarg);
+                break;
+            case OPT_ALPHA:
+                args->alpha = atoi(optarg);
+                break;
+            case OPT_AGING:
+                args->aging = string(optarg);
+                if (args->aging != "wheel" && args->aging != "counters") {
+                    printf("Invalid aging mode %s, expected wheel or counters\n", optarg);
+                    exit(1);
+                }
+                break;
+            case OPT_WORKERS:
+                args->workers = atoi(optarg);
+                if (args->workers == 0) {
+                    printf("Invalid number of workers %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case OPT_CALL_NS:
+                args->costs.call_ns = atoi(optarg);
+                break;
+            case OPT_ENTRY_NS:
+                args->costs.entry_ns = atoi(optarg);
+                break;
+            case OPT_SYNC_ENTRY_NS:
+                args->costs.sync_entry_ns = atoi(optarg);
+                break;
+            case OPT_SEED:
+                args->seed = atoi(optarg);
+                break;
+            case OPT_VERBOSE:
+                args->verbose = true;
+                break;
+            case OPT_EVENT_LOG:
+                args->event_log_path = string(optarg);
+                break;
+            case OPT_EVENT_LOG_LEVEL:
+                if (!EventLog::parse_level(string(optarg), args->event_log_level)) {
+                    printf("Invalid event log level %s, expected off, transitions, flags or all\n", optarg);
+                    exit(1);
+                }
+                break;
+            case OPT_LEARN:
+                args->learn = true;
+                break;
+            case OPT_RECONCILE_EVERY:
+                args->reconcile_every = atoi(optarg);
+                if (args->reconcile_every == 0) {
+                    printf("Invalid reconcile interval %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case OPT_CHECK:
+                args->check = true;
+                break;
+            default:
+                printf("Invalid option\n");
+                exit(1);
+        }
+    }
+
+    if(args->warmup >= args->epochs){
+        printf("Warm-up of %u epochs leaves nothing out of %u epochs\n", args->warmup, args->epochs);
+        exit(1);
+    }
+
+    return args;
+}
+
+// drops everything written to it
+class NullBuffer : public streambuf {
+    protected:
+        int overflow(int c){
+            return c;
+        }
+};
+
+// peak resident set size in kB
+uint64_t memory_high_water(){
+    ifstream status("/proc/self/status");
+    string line;
+
+    while(getline(status, line)){
+        if(line.compare(0, 6, "VmHWM:") == 0){
+            return strtoull(line.c_str() + 6, nullptr, 10);
+        }
+    }
+    return 0;
+}
+
+void print_phase(const string &name, vector<double> samples){
+    double sum = 0;
+    for(auto sample: samples){
+        sum += sample;
+    }
+    sort(samples.begin(), samples.end());
+
+    size_t n = samples.size();
+    size_t p50 = max((size_t) ceil(0.50 * n), (size_t) 1) - 1;
+    size_t p99 = max((size_t) ceil(0.99 * n), (size_t) 1) - 1;
+
+    printf("%-14s %10.3f %10.3f %10.3f %10.3f\n", name.c_str(), sum / n, samples[p50], samples[p99], samples[n - 1]);
+}
+
+// global_table and dark_meter entries that differ between the two switches
+uint32_t count_mismatches(SimSwitch *a, SimSwitch *b){
+    uint32_t mismatches = 0;
+
+    for(uint32_t t = 0; t < Index::BANKS; t++){
+        string name = Index::register_name("global_table", t);
+        SimRegisterState *state_a = a->register_state(name);
+        SimRegisterState *state_b = b->register_state(name);
+        for(uint32_t pipe = 0; pipe < state_a->hw.size(); pipe++){
+            for(uint32_t i = 0; i < state_a->size; i++){
+                mismatches += state_a->hw[pipe][i] != state_b->hw[pipe][i];
+            }
+        }
+    }
+
+    if(PROGRAM::HAS_METERS){
+        vector<SimMeterEntry> *meter_a = a->meter_state("pipe.Ingress.dark_meter");
+        vector<SimMeterEntry> *meter_b = b->meter_state("pipe.Ingress.dark_meter");
+        for(uint32_t i = 0; i < meter_a->size(); i++){
+            const SimMeterEntry &entry_a = (*meter_a)[i];
+            const SimMeterEntry &entry_b = (*meter_b)[i];
+            mismatches += entry_a.cir_pps != entry_b.cir_pps || entry_a.pir_pps != entry_b.pir_pps ||
+                            entry_a.cbs_pkts != entry_b.cbs_pkts || entry_a.pbs_pkts != entry_b.pbs_pkts;
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char **argv){
+    BenchArgs* bench = parse_bench_options(argc, argv);
+
+    uint32_t addr_cnt = 1U << (PROGRAM::Family::UNIT_LEN - bench->prefix_len);
+    uint8_t addr[PROGRAM::Family::ADDR_BYTES];
+    Index::parse(base_prefix, addr);
+    uint64_t base_unit = Index::unit(addr);
+    uint32_t active_cnt = (uint32_t) (bench->density * addr_cnt);
+    uint32_t churn_cnt = (uint32_t) (bench->churn * active_cnt);
+
+    // the monitored prefix is read from a file, like in a deployment
+    char monitored_path[] = "/tmp/bench_monitoredXXXXXX";
+    int fd = mkstemp(monitored_path);
+    if(fd < 0){
+        printf("Could not create the monitored prefixes file\n");
+        exit(1);
+    }
+    close(fd);
+    ofstream monitored(monitored_path);
+    monitored << base_prefix << "/" << bench->prefix_len << endl;
+    monitored.close();
+
+    Args<PROGRAM>* args = new Args<PROGRAM>;
+    args->monitored_path = monitored_path;
+    args->prefixes_path = "";
+    args->event_log_path = bench->event_log_path;
+    args->event_log_level = bench->event_log_level;
+    args->global_table_size = max(addr_cnt / Index::BANKS, (uint32_t) SHARD_ALIGN);
+    args->alpha = bench->alpha;
+    args->aging = bench->aging;
+    args->workers = bench->workers;
+    args->learn = bench->learn;
+    args->reconcile_every = bench->reconcile_every;
+
+    // the controller logs every flagged address, keep it out of the report
+    streambuf *cout_buf = cout.rdbuf();
+    NullBuffer discard;
+    if(!bench->verbose){
+        cout.rdbuf(&discard);
+    }
+
+    SimSwitch *sim = new SimSwitch(PROGRAM::NUM_PIPES, args->global_table_size, args->dark_meter_size, bench->costs);
+    LocalClient<PROGRAM> *local_client = new LocalClient<PROGRAM>(args, sim);
+
+    // reference controller with one worker, on its own switch
+    SimSwitch *ref_sim = nullptr;
+    LocalClient<PROGRAM> *ref_client = nullptr;
+    if(bench->check){
+        Args<PROGRAM>* ref_args = new Args<PROGRAM>(*args);
+        ref_args->workers = 1;
+        ref_args->event_log_path = "";
+        ref_sim = new SimSwitch(PROGRAM::NUM_PIPES, args->global_table_size, args->dark_meter_size, bench->costs);
+        ref_client = new LocalClient<PROGRAM>(ref_args, ref_sim);
+    }
+    unlink(monitored_path);
+
+    uint64_t setup_hwm = memory_high_water();
+
+    // initial active set, then churn_cnt replacements per epoch
+    mt19937 rng(bench->seed);
+    uniform_int_distribution<uint32_t> pick_addr(0, addr_cnt - 1);
+    vector<bool> is_active(addr_cnt, false);
+    vector<uint32_t> active;
+
+    while(active.size() < active_cnt){
+        uint32_t offset = pick_addr(rng);
+        if(!is_active[offset]){
+            is_active[offset] = true;
+            active.push_back(offset);
+        }
+    }
+
+    vector<double> sync_ms, read_ms, classify_ms, global_write_ms, flag_reset_ms, meter_update_ms, total_ms;
+    uint32_t mismatched_epochs = 0;
+
+    for(uint32_t epoch = 0; epoch < bench->epochs; epoch++){
+        if(!active.empty() && active_cnt < addr_cnt){
+            uniform_int_distribution<uint32_t> pick_active(0, active.size() - 1);
+            for(uint32_t i = 0; i < churn_cnt; i++){
+                uint32_t pos = pick_active(rng);
+                uint32_t offset = pick_addr(rng);
+                while(is_active[offset]){
+                    offset = pick_addr(rng);
+                }
+                is_active[active[pos]] = false;
+                is_active[offset] = true;
+                active[pos] = offset;
+            }
+        }
+
+        for(auto offset: active){
+            Index::unit_addr(base_unit | offset, addr);
+            sim->packet_out<PROGRAM>(addr, 0);
+            if(ref_sim != nullptr){
+                ref_sim->packet_out<PROGRAM>(addr, 0);
+            }
+        }
+
+        EpochStats stats = local_client->run_epoch();
+        if(ref_client != nullptr){
+            ref_client->run_epoch();
+            uint32_t mismatches = count_mismatches(sim, ref_sim);
+            if(mismatches){
+                cerr << "Epoch " << epoch << ": " << mismatches << " entries differ from one worker" << endl;
+                mismatched_epochs++;
+            }
+        }
+        if(epoch < bench->warmup){
+            continue;
+        }
+
+        sync_ms.push_back(stats.sync_ms);
+        read_ms.push_back(stats.read_ms);
+        classify_ms.push_back(stats.classify_ms);
+        global_write_ms.push_back(stats.global_write_ms);
+        flag_reset_ms.push_back(stats.flag_reset_ms);
+        meter_update_ms.push_back(stats.meter_update_ms);
+        total_ms.push_back(stats.total_ms);
+    }
+
+    cout.rdbuf(cout_buf);
+
+    printf("prefix %s/%u: %u addresses, %u active, %u replaced per epoch\n",
+            base_prefix, bench->prefix_len, addr_cnt, active_cnt, churn_cnt);
+    printf("aging %s, alpha %u, %u workers, %u epochs after %u warm-up\n",
+            bench->aging.c_str(), bench->alpha, bench->workers, bench->epochs - bench->warmup, bench->warmup);
+    if(bench->learn){
+        printf("flags learned from digests, flag_table read every %u epochs\n", bench->reconcile_every);
+    }
+    printf("%-14s %10s %10s %10s %10s\n", "phase (ms)", "mean", "p50", "p99", "max");
+    print_phase("sync", sync_ms);
+    print_phase("read", read_ms);
+    print_phase("classify", classify_ms);
+    print_phase("global write", global_write_ms);
+    print_phase("flag reset", flag_reset_ms);
+    print_phase("meter update", meter_update_ms);
+    print_phase("epoch", total_ms);
+    printf("memory high-water: %lu kB after setup, %lu kB at the end\n",
+            (unsigned long) setup_hwm, (unsigned long) memory_high_water());
+    if(bench->check){
+        printf("check against one worker: %u of %u epochs differ\n", mismatched_epochs, bench->epochs);
+        return mismatched_epochs ? 1 : 0;
+    }
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+# Builds the controller core for one telescope program. Included by the
+# Makefile in the controller_cpp directory of each program, which sets
+# PROGRAM (a traits struct of Programs.h) and NAME (the binary prefix);
+# the objects and binaries are written next to that Makefile.
+
+CORE_DIR := $(patsubst %/,%,$(dir $(lastword $(MAKEFILE_LIST))))
+VPATH := $(CORE_DIR)
+
+# the sim, bench, dump and clean targets need no SDE
+ifeq ($(filter sim bench dump clean,$(MAKECMDGOALS)),)
+ifndef SDE_INSTALL
+$(error SDE_INSTALL is not set)
+endif
+endif
+
+CXX := /usr/bin/gcc
+PROGRAM_FLAGS := -I$(CORE_DIR) -DPROGRAM=$(PROGRAM) -DPROG_NAME=\"telescope\"
+CPPFLAGS := -I$(SDE_INSTALL)/include -DSDE_INSTALL=\"$(SDE_INSTALL)\" $(PROGRAM_FLAGS)
+CXXFLAGS = -g -O2 -std=c++17 -Wall -Wextra -Werror -MMD -MF $@.d
+BF_LIBS  := -L$(SDE_INSTALL)/lib -ldriver -ltarget_utils -ltarget_sys
+LDLIBS   := $(BF_LIBS) -lm -ldl -lpthread -lrt -lstdc++
+LDFLAGS  := -Wl,-rpath,$(SDE_INSTALL)/lib
+
+CORE_SOURCES := EpochKernel.cpp AgingWheel.cpp BankPipeline.cpp Metrics.cpp MetricsServer.cpp \
+			EventLog.cpp MeterCache.cpp PrefixMap.cpp ActivityFeed.cpp Checkpoint.cpp FlagQueue.cpp LocalClient.cpp
+COMMON_SOURCES := $(CORE_SOURCES) main.cpp
+SOURCES := BfRtRegister.cpp BfRtForwardTable.cpp BfRtNode.cpp BfRtMonitoredTable.cpp BfRtMulticastGroup.cpp \
+			BfRtPortManager.cpp BfRtMirrorManager.cpp BfRtMeter.cpp BfRtPortsTable.cpp BfRtFlagDigest.cpp \
+			BfRtBackend.cpp $(COMMON_SOURCES)
+SIM_SOURCES := SimSwitch.cpp $(COMMON_SOURCES)
+BENCH_SOURCES := SimSwitch.cpp $(CORE_SOURCES) bench.cpp
+
+OBJS := $(SOURCES:.cpp=.o)
+SIM_OBJS := $(SIM_SOURCES:.cpp=.sim.o)
+BENCH_OBJS := $(BENCH_SOURCES:.cpp=.sim.o)
+
+TARGET := $(NAME)
+SIM_TARGET := $(NAME)_sim
+BENCH_TARGET := $(NAME)_bench
+DUMP_TARGET := event_log_dump
+
+all: $(TARGET)
+
+$(TARGET): $(OBJS)
+	$(CXX) $(CXXFLAGS) $(CPPFLAGS) -o $@ $(OBJS) $(LDLIBS) $(LDFLAGS)
+
+sim: $(SIM_TARGET)
+
+%.sim.o: %.cpp
+	$(CXX) $(CXXFLAGS) -DSIM_SWITCH $(PROGRAM_FLAGS) -c -o $@ $<
+
+$(SIM_TARGET): $(SIM_OBJS)
+	$(CXX) $(CXXFLAGS) -o $@ $(SIM_OBJS) -lm -lpthread -lrt -lstdc++
+
+# epoch latency benchmark, see bench.cpp
+bench: $(BENCH_TARGET)
+
+$(BENCH_TARGET): $(BENCH_OBJS)
+	$(CXX) $(CXXFLAGS) -o $@ $(BENCH_OBJS) -lm -lpthread -lrt -lstdc++
+
+# converts event logs to text
+dump: $(DUMP_TARGET)
+
+$(DUMP_TARGET): EventLogDump.cpp EventLog.h
+	$(CXX) $(CXXFLAGS) -o $@ $< -lstdc++
+
+.PHONY: all sim bench dump clean
+
+clean:
+	-@rm -f $(OBJS) $(SIM_OBJS) $(BENCH_OBJS) zlog-cfg-cur bf_drivers.log* *.d *~ $(TARGET) $(SIM_TARGET) $(BENCH_TARGET) $(DUMP_TARGET)
@@ -0,0 +1,274 @@
+#include "LocalClient.h"
+
+#include <stdio.h>
+#include <unistd.h>
+#include <getopt.h>
+
+#ifdef SIM_SWITCH
+#include "SimSwitch.h"
+#else
+#include "BfRtBackend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <bf_rt/bf_rt_common.h>
+#include <bf_switchd/bf_switchd.h>
+#ifdef __cplusplus
+}
+#endif
+#endif
+
+#define SDE_INSTALL "/home/p4user/bf-sde-9.13.4/install"
+#define CONF_FILE_DIR "share/p4/targets/"
+#define CONF_FILE_PATH(prog) \
+    (string(SDE_INSTALL "/" CONF_FILE_DIR) + PROGRAM::TARGET + "/" prog ".conf")
+
+#define OPT_INTERVAL 0
+#define OPT_GLOBAL_TABLE_SIZE 1
+#define OPT_DARK_METER_SIZE 2
+#define OPT_MAX_PACKET_RATE 3
+#define OPT_AVG_PACKET_RATE 4
+#define OPT_MAX_BYTE_RATE 5
+#define OPT_AVG_BYTE_RATE 6
+#define OPT_ALPHA 7
+#define OPT_MONITORED 8
+#define OPT_OUTGOING 9
+#define OPT_INCOMING 10
+#define OPT_AGING 11
+#define OPT_WORKERS 12
+#define OPT_METRICS_PORT 13
+#define OPT_METRICS_SOCKET 14
+#define OPT_EVENT_LOG 15
+#define OPT_EVENT_LOG_LEVEL 16
+#define OPT_EVENT_LOG_SIZE 17
+#define OPT_ACTIVITY_FEED 18
+#define OPT_CHECKPOINT 19
+#define OPT_CHECKPOINT_EVERY 20
+#define OPT_LEARN 21
+#define OPT_RECONCILE_EVERY 22
+
+using namespace std;
+
+Args<PROGRAM>* parse_options(int argc, char **argv){
+    int option_index = 0;
+    Args<PROGRAM>* args = new Args<PROGRAM>;
+
+    vector<struct option> options = {
+        {"interval", required_argument, 0, OPT_INTERVAL},
+        {"global-table-size", required_argument, 0, OPT_GLOBAL_TABLE_SIZE},
+        {"alpha", required_argument, 0, OPT_ALPHA},
+        {"monitored", required_argument, 0, OPT_MONITORED},
+        {"outgoing", required_argument, 0, OPT_OUTGOING},
+        {"incoming", required_argument, 0, OPT_INCOMING},
+        {"aging", required_argument, 0, OPT_AGING},
+        {"workers", required_argument, 0, OPT_WORKERS},
+        {"metrics-port", required_argument, 0, OPT_METRICS_PORT},
+        {"metrics-socket", required_argument, 0, OPT_METRICS_SOCKET},
+        {"event-log", required_argument, 0, OPT_EVENT_LOG},
+        {"event-log-level", required_argument, 0, OPT_EVENT_LOG_LEVEL},
+        {"event-log-size", required_argument, 0, OPT_EVENT_LOG_SIZE},
+        {"activity-feed", required_argument, 0, OPT_ACTIVITY_FEED},
+        {"checkpoint", required_argument, 0, OPT_CHECKPOINT},
+        {"checkpoint-every", required_argument, 0, OPT_CHECKPOINT_EVERY},
+        {"learn", no_argument, 0, OPT_LEARN},
+        {"reconcile-every", required_argument, 0, OPT_RECONCILE_EVERY},
+    };
+    // only for programs with a dark_meter
+    if(PROGRAM::HAS_METERS){
+        options.push_back({"dark-meter-size", required_argument, 0, OPT_DARK_METER_SIZE});
+        options.push_back({"max-packet-rate", required_argument, 0, OPT_MAX_PACKET_RATE});
+        options.push_back({"avg-packet-rate", required_argument, 0, OPT_AVG_PACKET_RATE});
+        options.push_back({"max-byte-rate", required_argument, 0, OPT_MAX_BYTE_RATE});
+        options.push_back({"avg-byte-rate", required_argument, 0, OPT_AVG_BYTE_RATE});
+    }
+    options.push_back({NULL, 0, 0, 0});
+
+    bool incoming_ports = false;
+    bool outgoing_ports = false;
+
+    while(1){
+        int opt = getopt_long(argc, argv, "", options.data(), &option_index);
+
+        if(opt == -1){
+            break;
+        }
+
+        switch(opt){
+            case OPT_INTERVAL:
+                args->time_interval = atoi(optarg);
+                break;
+            case OPT_GLOBAL_TABLE_SIZE:
+                args->global_table_size = atoi(optarg);
+                break;
+            case OPT_DARK_METER_SIZE:
+                args->dark_meter_size = atoi(optarg);
+                break;
+            case OPT_MAX_PACKET_RATE:
+                args->max_pkt_rate = atoi(optarg);
+                break;
+            case OPT_AVG_PACKET_RATE:
+                args->avg_pkt_rate = atoi(optarg);
+                break;
+            case OPT_MAX_BYTE_RATE:
+                args->max_byte_rate = atoi(optarg);
+                break;
+            case OPT_AVG_BYTE_RATE:
+                args->avg_byte_rate = atoi(optarg);
+                break;
+            case OPT_ALPHA:
+                args->alpha = atoi(optarg);
+                break;
+            case OPT_MONITORED:
+                args->monitored_path = string(optarg);
+                break;
+            case OPT_OUTGOING:
+                if (!outgoing_ports) { 
+                    outgoing_ports = true;
+                    args->outgoing.clear();
+                }
+                args->outgoing.push_back((uint16_t) atoi(optarg));
+                break;
+            case OPT_INCOMING:
+                if (!incoming_ports) { 
+                    incoming_ports = true;
+                    args->incoming.clear();
+                }
+                args->incoming.push_back((uint16_t) atoi(optarg));
+                break;
+            case OPT_AGING:
+                args->aging = string(optarg);
+                if (args->aging != "wheel" && args->aging != "counters") {
+                    printf("Invalid aging mode %s, expected wheel or counters\n", optarg);
+                    exit(1);
+                }
+                break;
+            case OPT_WORKERS:
+                args->workers = atoi(optarg);
+                if (args->workers == 0) {
+                    printf("Invalid number of workers %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case OPT_METRICS_PORT:
+                args->metrics_port = atoi(optarg);
+                break;
+            case OPT_METRICS_SOCKET:
+                args->metrics_socket = string(optarg);
+                break;
+            case OPT_EVENT_LOG:
+                args->event_log_path = string(optarg);
+                break;
+            case OPT_EVENT_LOG_LEVEL:
+                if (!EventLog::parse_level(string(optarg), args->event_log_level)) {
+                    printf("Invalid event log level %s, expected off, transitions, flags or all\n", optarg);
+                    exit(1);
+                }
+                break;
+            case OPT_EVENT_LOG_SIZE:
+                args->event_log_size = atoi(optarg);
+                break;
+            case OPT_ACTIVITY_FEED:
+                args->activity_feed = string(optarg);
+                break;
+            case OPT_CHECKPOINT:
+                args->checkpoint_path = string(optarg);
+                break;
+            case OPT_CHECKPOINT_EVERY:
+                args->checkpoint_every = atoi(optarg);
+                if (args->checkpoint_every == 0) {
+                    printf("Invalid checkpoint interval %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case OPT_LEARN:
+                args->learn = true;
+                break;
+            case OPT_RECONCILE_EVERY:
+                args->reconcile_every = atoi(optarg);
+                if (args->reconcile_every == 0) {
+                    printf("Invalid reconcile interval %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            default:
+                printf("Invalid option\n");
+                break;
+        }
+    }
+
+    return args;
+}
+
+#ifdef SIM_SWITCH
+// runs the controller against the in-memory switch; no SDE or root needed
+int main(int argc, char **argv){
+    Args<PROGRAM>* args = parse_options(argc, argv);
+    printf("Parsed options\n");
+
+    SimSwitch *sim = new SimSwitch(PROGRAM::NUM_PIPES, args->global_table_size, args->dark_meter_size);
+    LocalClient<PROGRAM> *local_client = new LocalClient<PROGRAM>(args, sim);
+    local_client->run();
+
+    return 0;
+}
+#else
+int main(int argc, char **argv){
+    /* Shared API variables */
+    bf_rt_target_t dev_tgt;
+    const BfRtInfo *bf_rt_info = nullptr;
+
+    bf_switchd_context_t *switchd_ctx;
+    bf_status_t bf_status;
+
+    /* Check if root privileges exist or not, exit if not. */
+    if (geteuid() != 0) {
+        printf("This program must be run as root user \n");
+        exit(1);
+    }
+
+    /* Allocate memory for the libbf_switchd context. */
+    switchd_ctx = (bf_switchd_context_t *)calloc(1, sizeof(bf_switchd_context_t));
+    if (!switchd_ctx) {
+        printf("Cannot Allocate switchd context\n");
+        exit(1);
+    }
+
+    /* Initialize the switchd context */
+    switchd_ctx->install_dir           = strdup(SDE_INSTALL);
+    switchd_ctx->conf_file             = strdup(CONF_FILE_PATH(PROG_NAME).c_str());
+    switchd_ctx->running_in_background = true; // no cli
+    switchd_ctx->dev_sts_thread        = true; 
+    switchd_ctx->dev_sts_port          = 7777; //INIT_STATUS_TCP_PORT;
+
+    /* Setup the device */
+    memset(&dev_tgt, 0, sizeof(dev_tgt));
+    dev_tgt.dev_id = 0;
+    dev_tgt.pipe_id = BF_DEV_PIPE_ALL;
+
+    /* Initialize the device */
+    bf_status = bf_switchd_lib_init(switchd_ctx);
+    if (bf_status != BF_SUCCESS) {
+        printf("Failed to initialize device: %s\n", bf_err_str(bf_status));
+        free(switchd_ctx);
+        exit(1);
+    }
+
+    /* Retrieve BfRtInfo */
+    auto &dev_mgr = BfRtDevMgr::getInstance();
+    bf_status = dev_mgr.bfRtInfoGet(dev_tgt.dev_id, "telescope", &bf_rt_info);
+    bf_sys_assert(bf_status == BF_SUCCESS);
+    
+    Args<PROGRAM>* args = parse_options(argc, argv);
+    printf("Parsed options\n");
+    
+    BfRtBackend *backend = new BfRtBackend(dev_tgt, bf_rt_info);
+    LocalClient<PROGRAM> *local_client = new LocalClient<PROGRAM>(args, backend);
+    local_client->run();
+
+    if (switchd_ctx) free(switchd_ctx);
+
+    return bf_status;
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "capture_file.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <rte_common.h>
+#include <rte_eal.h>
+
+static std::string capture_file_name(struct capture_files *files, uint32_t num) {
+    return files->prefix + std::to_string(num) + PCAP_FILE_EXT;
+}
+
+static int capture_file_open(struct capture_files *files, uint32_t num) {
+
+    std::string filename = capture_file_name(files, num);
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    if (files->direct) {
+        flags |= O_DIRECT;
+    }
+
+    int fd = open(filename.c_str(), flags, 0644);
+    if (fd < 0) {
+        rte_exit(EXIT_FAILURE, "Failed to create the packet capture file %s\n",
+                 filename.c_str());
+    }
+    return fd;
+}
+
+static void capture_file_close(struct capture_files *files) {
+    close(files->fd);
+    files->fd = -1;
+}
+
+void capture_files_init(struct capture_files *files, const std::string &prefix, bool direct) {
+    files->prefix = prefix;
+    files->direct = direct;
+    files->num = 0;
+    files->fd = capture_file_open(files, 0);
+    files->offset = 0;
+    files->next_fd = -1;
+    files->next_num = 0;
+}
+
+void capture_files_prepare_next(struct capture_files *files) {
+    if (files->next_fd < 0) {
+        files->next_num = files->num + 1;
+        files->next_fd = capture_file_open(files, files->next_num);
+    }
+}
+
+void capture_files_switch(struct capture_files *files, uint32_t num) {
+
+    capture_file_close(files);
+
+    /* Only opens the file here if nobody prepared it */
+    if (files->next_fd >= 0 && files->next_num == num) {
+        files->fd = files->next_fd;
+        files->next_fd = -1;
+    }
+    else {
+        files->fd = capture_file_open(files, num);
+    }
+    files->num = num;
+    files->offset = 0;
+}
+
+uint64_t capture_files_append(struct capture_files *files, uint32_t len, uint32_t *write_len) {
+
+    uint64_t offset = files->offset;
+
+    /* O_DIRECT buffers arrive padded to CAPTURE_DIRECT_ALIGN */
+    *write_len = len;
+    files->offset += len;
+    return offset;
+}
+
+void capture_files_close(struct capture_files *files) {
+    capture_file_close(files);
+    if (files->next_fd >= 0) {
+        close(files->next_fd);
+        files->next_fd = -1;
+        unlink(capture_file_name(files, files->next_num).c_str());
+    }
+}
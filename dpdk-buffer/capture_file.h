@@ -0,0 +1,53 @@
+#ifndef CAPTURE_FILE_H
+#define CAPTURE_FILE_H
+
+#include <stdint.h>
+#include <string>
+
+/* Packet capture file name */
+#define PCAP_FILE_NAME           "packets."
+#define PCAP_FILE_EXT            ".pcap"
+
+/* Alignment of the offsets, lengths and buffers of O_DIRECT writes */
+#define CAPTURE_DIRECT_ALIGN     (4096u)
+
+/**
+ * The sequence of capture files, "<prefix><num>.pcap"
+ *
+ * Only the current file is written to. The file that follows it can be
+ * opened ahead of time, so switching files does not wait for the file
+ * system. With O_DIRECT, the capture output pads every buffer to a multiple
+ * of CAPTURE_DIRECT_ALIGN with a pcapng custom block, so the writes stay
+ * aligned and the files stay readable.
+ */
+struct capture_files {
+    std::string prefix;
+    bool direct;
+
+    int fd;
+    uint32_t num;
+    uint64_t offset;             /* offset of the next write */
+
+    int next_fd;                 /* -1 until it is opened */
+    uint32_t next_num;
+};
+
+/* Open the first file. Exits the application on failure */
+void capture_files_init(struct capture_files *files, const std::string &prefix, bool direct);
+
+/* Open the file that follows the current one, if it is not open yet */
+void capture_files_prepare_next(struct capture_files *files);
+
+/* Close the current file and continue with file num */
+void capture_files_switch(struct capture_files *files, uint32_t num);
+
+/**
+ * Reserve room for len bytes at the end of the current file.
+ * Returns the offset to write at and sets write_len to the length to write.
+ */
+uint64_t capture_files_append(struct capture_files *files, uint32_t len, uint32_t *write_len);
+
+/* Close the current file and remove the next one, which was never written */
+void capture_files_close(struct capture_files *files);
+
+#endif /* CAPTURE_FILE_H */
@@ -0,0 +1,409 @@
+#include "capture_output.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_eal.h>
+#include <rte_malloc.h>
+
+/* pcapng block types */
+#define PCAPNG_SHB_TYPE          (0x0A0D0D0Au)
+#define PCAPNG_IDB_TYPE          (1u)
+#define PCAPNG_EPB_TYPE          (6u)
+/* Custom block that readers skip and must not copy */
+#define PCAPNG_CB_TYPE           (0x40000BADu)
+
+/* Enterprise number of the custom blocks, the one RFC 5612 reserves for examples */
+#define PCAPNG_CB_PEN            (32473u)
+
+#define PCAPNG_BYTE_ORDER_MAGIC  (0x1A2B3C4Du)
+#define PCAPNG_LINKTYPE_ETHERNET (1u)
+
+/* Interface option giving the timestamp resolution, here nanoseconds */
+#define PCAPNG_IF_TSRESOL        (9u)
+
+#define NS_PER_S                 (1000000000ull)
+
+/* Section header block, without options */
+struct __attribute__((packed)) pcapng_shb {
+    uint32_t block_type;
+    uint32_t block_length;
+    uint32_t byte_order_magic;
+    uint16_t major_version;
+    uint16_t minor_version;
+    int64_t section_length;
+    uint32_t block_length_trailer;
+};
+
+/* Interface description block with the if_tsresol option */
+struct __attribute__((packed)) pcapng_idb {
+    uint32_t block_type;
+    uint32_t block_length;
+    uint16_t link_type;
+    uint16_t reserved;
+    uint32_t snap_len;
+    uint16_t tsresol_code;
+    uint16_t tsresol_length;
+    uint8_t tsresol[4];          /* one byte of value, padded */
+    uint16_t end_code;
+    uint16_t end_length;
+    uint32_t block_length_trailer;
+};
+
+/* Enhanced packet block, followed by the padded packet and the length */
+struct __attribute__((packed)) pcapng_epb {
+    uint32_t block_type;
+    uint32_t block_length;
+    uint32_t interface_id;
+    uint32_t timestamp_hi;
+    uint32_t timestamp_lo;
+    uint32_t captured_length;
+    uint32_t original_length;
+};
+
+/* Custom block, followed by the padding and the length */
+struct __attribute__((packed)) pcapng_cb {
+    uint32_t block_type;
+    uint32_t block_length;
+    uint32_t pen;
+};
+
+/* Smallest custom block */
+#define PCAPNG_CB_MIN_LEN        (sizeof(struct pcapng_cb) + sizeof(uint32_t))
+
+/**
+ * Write the blocks every capture file starts with
+ */
+static uint32_t pcapng_write_header(uint8_t *data) {
+
+    struct pcapng_shb *shb = (struct pcapng_shb *)data;
+    memset(shb, 0, sizeof(struct pcapng_shb));
+    shb->block_type = PCAPNG_SHB_TYPE;
+    shb->block_length = sizeof(struct pcapng_shb);
+    shb->byte_order_magic = PCAPNG_BYTE_ORDER_MAGIC;
+    shb->major_version = 1;
+    shb->minor_version = 0;
+    shb->section_length = -1;
+    shb->block_length_trailer = sizeof(struct pcapng_shb);
+
+    struct pcapng_idb *idb = (struct pcapng_idb *)(data + sizeof(struct pcapng_shb));
+    memset(idb, 0, sizeof(struct pcapng_idb));
+    idb->block_type = PCAPNG_IDB_TYPE;
+    idb->block_length = sizeof(struct pcapng_idb);
+    idb->link_type = PCAPNG_LINKTYPE_ETHERNET;
+    idb->snap_len = 0;
+    idb->tsresol_code = PCAPNG_IF_TSRESOL;
+    idb->tsresol_length = 1;
+    idb->tsresol[0] = 9;
+    idb->block_length_trailer = sizeof(struct pcapng_idb);
+
+    return sizeof(struct pcapng_shb) + sizeof(struct pcapng_idb);
+}
+
+/**
+ * Fill the buffer up to a multiple of CAPTURE_DIRECT_ALIGN with a custom
+ * block, so O_DIRECT writes cover whole blocks of the file and readers skip
+ * the padding. The buffer has CAPTURE_DIRECT_ALIGN bytes of room left, see
+ * capture_output_reserve
+ */
+static void capture_output_pad(struct capture_output *out) {
+
+    struct capture_buffer *buf = out->buf;
+    uint32_t pad_len = RTE_ALIGN_CEIL(buf->len, CAPTURE_DIRECT_ALIGN) - buf->len;
+    if (pad_len == 0) {
+        return;
+    }
+    if (pad_len < PCAPNG_CB_MIN_LEN) {
+        pad_len += CAPTURE_DIRECT_ALIGN;
+    }
+
+    uint8_t *block = buf->data + buf->len;
+    struct pcapng_cb *cb = (struct pcapng_cb *)block;
+    cb->block_type = PCAPNG_CB_TYPE;
+    cb->block_length = pad_len;
+    cb->pen = PCAPNG_CB_PEN;
+    memset(block + sizeof(struct pcapng_cb), 0, pad_len - PCAPNG_CB_MIN_LEN);
+    memcpy(block + pad_len - sizeof(uint32_t), &pad_len, sizeof(uint32_t));
+
+    buf->len += pad_len;
+    out->file_bytes += pad_len;
+}
+
+/**
+ * Write out the buffer being filled
+ */
+static void capture_output_submit(struct capture_output *out) {
+
+    if (out->direct) {
+        capture_output_pad(out);
+    }
+
+    struct capture_buffer *buf = out->buf;
+    out->buf = NULL;
+
+    if (out->writer) {
+        /* The full ring holds every buffer, so this cannot fail */
+        rte_ring_sp_enqueue(out->full_ring, buf);
+        return;
+    }
+
+    if (buf->file_num != out->files.num) {
+        capture_files_switch(&out->files, buf->file_num);
+    }
+    uint32_t write_len;
+    uint64_t offset = capture_files_append(&out->files, buf->len, &write_len);
+    uint32_t done = 0;
+    while (done < write_len) {
+        ssize_t res = pwrite(out->files.fd, buf->data + done, write_len - done, offset + done);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            printf("Failed to write to capture file %u: %s\n", out->files.num, strerror(errno));
+            break;
+        }
+        done += res;
+        if (done < write_len && (res == 0 || out->direct)) {
+            /* No progress, or a rest that O_DIRECT cannot write at its unaligned offset */
+            printf("Failed to write to capture file %u: short write of %zd bytes\n", out->files.num, res);
+            break;
+        }
+    }
+    rte_ring_sp_enqueue(out->free_ring, buf);
+}
+
+/**
+ * Continue with the next file
+ */
+static void capture_output_rotate(struct capture_output *out) {
+
+    if (out->buf) {
+        capture_output_submit(out);
+    }
+    out->file_num++;
+    out->file_bytes = 0;
+    out->file_opened_ts = rte_get_timer_cycles();
+    printf("Captured %" PRIu64 " packets (%" PRIu64 " dropped), switched to capture file %u\n",
+           out->captured_pkts, out->dropped_pkts, out->file_num);
+}
+
+/**
+ * Make room for len bytes in the buffer being filled; false if there is no
+ * free buffer
+ */
+static bool capture_output_reserve(struct capture_output *out, uint32_t len) {
+
+    /* O_DIRECT buffers keep room for the padding */
+    uint32_t buf_size = out->direct ? CAPTURE_BUFFER_SIZE - CAPTURE_DIRECT_ALIGN : CAPTURE_BUFFER_SIZE;
+
+    if (out->buf && out->buf->len + len > buf_size) {
+        capture_output_submit(out);
+    }
+    if (!out->buf) {
+        if (rte_ring_sc_dequeue(out->free_ring, (void **)&out->buf)) {
+            return false;
+        }
+        out->buf->len = 0;
+        out->buf->file_num = out->file_num;
+        out->buf_ts = rte_get_timer_cycles();
+    }
+    if (out->file_bytes == 0) {
+        uint32_t header_len = pcapng_write_header(out->buf->data + out->buf->len);
+        out->buf->len += header_len;
+        out->file_bytes += header_len;
+    }
+    return true;
+}
+
+struct capture_output *capture_output_create(const std::string &prefix, uint32_t id,
+                                             uint64_t max_file_bytes,
+                                             uint32_t max_file_seconds,
+                                             bool use_writer, bool direct,
+                                             int socket_id) {
+
+    struct capture_output *out = new struct capture_output;
+
+    out->max_file_bytes = max_file_bytes;
+    out->max_file_cycles = max_file_seconds * rte_get_timer_hz();
+    out->direct = direct;
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    out->epoch_cycles = rte_get_timer_cycles();
+    out->epoch_ns = now.tv_sec * NS_PER_S + now.tv_nsec;
+    out->hz = rte_get_timer_hz();
+
+    /* Allocate the buffers; aligned for O_DIRECT */
+    out->nb_buffers = use_writer ? CAPTURE_WRITER_BUFFERS : CAPTURE_INLINE_BUFFERS;
+    out->buffers = new struct capture_buffer[out->nb_buffers];
+    std::string free_ring_name = "CAPTURE_FREE_RING_" + std::to_string(id);
+    out->free_ring = rte_ring_create(free_ring_name.c_str(), out->nb_buffers, socket_id,
+                                     RING_F_SP_ENQ | RING_F_SC_DEQ | RING_F_EXACT_SZ);
+    if (!out->free_ring) {
+        rte_exit(EXIT_FAILURE, "Cannot create the capture buffer ring\n");
+    }
+    for (uint32_t i = 0; i < out->nb_buffers; i++) {
+        out->buffers[i].data = (uint8_t *)rte_malloc_socket("CAPTURE_BUFFER", CAPTURE_BUFFER_SIZE,
+                                                            CAPTURE_DIRECT_ALIGN, socket_id);
+        if (!out->buffers[i].data) {
+            rte_exit(EXIT_FAILURE, "Cannot allocate the capture buffers\n");
+        }
+        rte_ring_sp_enqueue(out->free_ring, &out->buffers[i]);
+    }
+    out->buf = NULL;
+
+    out->file_num = 0;
+    out->file_bytes = 0;
+    out->file_opened_ts = rte_get_timer_cycles();
+
+    if (use_writer) {
+        std::string full_ring_name = "CAPTURE_FULL_RING_" + std::to_string(id);
+        out->full_ring = rte_ring_create(full_ring_name.c_str(), out->nb_buffers, socket_id,
+                                         RING_F_SP_ENQ | RING_F_SC_DEQ | RING_F_EXACT_SZ);
+        if (!out->full_ring) {
+            rte_exit(EXIT_FAILURE, "Cannot create the capture writer ring\n");
+        }
+        out->writer = capture_writer_create(prefix, direct, out->full_ring, out->free_ring);
+    }
+    else {
+        out->full_ring = NULL;
+        out->writer = NULL;
+        capture_files_init(&out->files, prefix, direct);
+        capture_files_prepare_next(&out->files);
+    }
+
+    out->captured_pkts = 0;
+    out->dropped_pkts = 0;
+
+    return out;
+}
+
+void capture_output_close(struct capture_output *out) {
+
+    if (out->buf) {
+        capture_output_submit(out);
+    }
+
+    if (out->writer) {
+        capture_writer_stop(out->writer);
+        rte_ring_free(out->full_ring);
+    }
+    else {
+        capture_files_close(&out->files);
+    }
+    printf("Captured %" PRIu64 " packets (%" PRIu64 " dropped)\n",
+           out->captured_pkts, out->dropped_pkts);
+
+    for (uint32_t i = 0; i < out->nb_buffers; i++) {
+        rte_free(out->buffers[i].data);
+    }
+    delete[] out->buffers;
+    rte_ring_free(out->free_ring);
+    delete out;
+}
+
+/**
+ * Start the block of a packet, with room for cap_len bytes of it; returns
+ * where to copy them, or NULL if there is no free buffer
+ */
+static uint8_t *capture_output_start_block(struct capture_output *out, uint32_t cap_len,
+                                           uint32_t pkt_len, uint64_t arrival_ts) {
+
+    uint32_t block_len = sizeof(struct pcapng_epb) + RTE_ALIGN_CEIL(cap_len, 4) + sizeof(uint32_t);
+
+    if (unlikely(!capture_output_reserve(out, block_len))) {
+        out->dropped_pkts++;
+        return NULL;
+    }
+
+    uint8_t *block = out->buf->data + out->buf->len;
+
+    /* Arrival time in nanoseconds since the epoch */
+    uint64_t cycles = arrival_ts - out->epoch_cycles;
+    uint64_t ts = out->epoch_ns + cycles / out->hz * NS_PER_S + cycles % out->hz * NS_PER_S / out->hz;
+
+    struct pcapng_epb *epb = (struct pcapng_epb *)block;
+    epb->block_type = PCAPNG_EPB_TYPE;
+    epb->block_length = block_len;
+    epb->interface_id = 0;
+    epb->timestamp_hi = ts >> 32;
+    epb->timestamp_lo = (uint32_t)ts;
+    epb->captured_length = cap_len;
+    epb->original_length = pkt_len;
+
+    return block + sizeof(struct pcapng_epb);
+}
+
+/**
+ * Finish the block started last, once its packet bytes are copied
+ */
+static void capture_output_end_block(struct capture_output *out, uint32_t cap_len) {
+
+    uint8_t *block = out->buf->data + out->buf->len;
+    uint32_t block_len = sizeof(struct pcapng_epb) + RTE_ALIGN_CEIL(cap_len, 4) + sizeof(uint32_t);
+
+    uint8_t *pkt = block + sizeof(struct pcapng_epb);
+    memset(pkt + cap_len, 0, RTE_ALIGN_CEIL(cap_len, 4) - cap_len);
+    memcpy(block + block_len - sizeof(uint32_t), &block_len, sizeof(uint32_t));
+
+    out->buf->len += block_len;
+    out->file_bytes += block_len;
+    out->captured_pkts++;
+
+    if (out->max_file_bytes && out->file_bytes >= out->max_file_bytes) {
+        capture_output_rotate(out);
+    }
+}
+
+void capture_output_add(struct capture_output *out, struct rte_mbuf *mbuf, uint64_t arrival_ts) {
+
+    uint32_t pkt_len = rte_pktmbuf_pkt_len(mbuf);
+    uint8_t *pkt = capture_output_start_block(out, pkt_len, pkt_len, arrival_ts);
+    if (unlikely(!pkt)) {
+        return;
+    }
+
+    /* Copy the packet, which may span several segments */
+    const void *data = rte_pktmbuf_read(mbuf, 0, pkt_len, pkt);
+    if (data != pkt) {
+        memcpy(pkt, data, pkt_len);
+    }
+    capture_output_end_block(out, pkt_len);
+}
+
+void capture_output_add_data(struct capture_output *out, const uint8_t *data, uint32_t cap_len,
+                             uint32_t pkt_len, uint64_t arrival_ts) {
+
+    uint8_t *pkt = capture_output_start_block(out, cap_len, pkt_len, arrival_ts);
+    if (unlikely(!pkt)) {
+        return;
+    }
+    memcpy(pkt, data, cap_len);
+    capture_output_end_block(out, cap_len);
+}
+
+void capture_output_idle(struct capture_output *out) {
+
+    uint64_t curr_ts = rte_get_timer_cycles();
+
+    /* O_DIRECT files are written in whole buffers until their end */
+    if (out->buf && !out->direct &&
+        curr_ts - out->buf_ts >= CAPTURE_FLUSH_TIME_MS * out->hz / 1000) {
+        capture_output_submit(out);
+    }
+
+    if (out->max_file_cycles && out->file_bytes &&
+        curr_ts - out->file_opened_ts >= out->max_file_cycles) {
+        capture_output_rotate(out);
+    }
+
+    if (!out->writer) {
+        capture_files_prepare_next(&out->files);
+    }
+}
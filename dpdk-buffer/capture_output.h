@@ -0,0 +1,100 @@
+#ifndef CAPTURE_OUTPUT_H
+#define CAPTURE_OUTPUT_H
+
+#include <stdint.h>
+#include <string>
+
+#include <rte_mbuf.h>
+#include <rte_ring.h>
+
+#include "capture_file.h"
+#include "capture_writer.h"
+
+/* Size of the buffers the pcapng blocks are formatted into */
+#define CAPTURE_BUFFER_SIZE      (4u << 20)
+
+/**
+ * Number of buffers with a writer thread; they absorb storage stalls.
+ * Without it a buffer is written as soon as it is full, so two suffice.
+ */
+#define CAPTURE_WRITER_BUFFERS   (32u)
+#define CAPTURE_INLINE_BUFFERS   (2u)
+
+/* Age (in milliseconds) at which a partly filled buffer is written out */
+#define CAPTURE_FLUSH_TIME_MS    (100u)
+
+/**
+ * Output of the captured packets
+ *
+ * Packets are formatted as pcapng blocks into large buffers, stamped with
+ * their arrival time. Full buffers are either written by the calling lcore
+ * or handed to a capture_writer thread, which keeps storage latency off
+ * the calling lcore. Files are rotated when they reach a size or an age.
+ *
+ * With a writer, packets are dropped when every buffer is waiting to be
+ * written, rather than stalling the caller.
+ */
+struct capture_output {
+    uint64_t max_file_bytes;     /* 0 to not rotate by size */
+    uint64_t max_file_cycles;    /* 0 to not rotate by time */
+    bool direct;
+
+    /* Conversion of timer cycles to nanoseconds since the epoch */
+    uint64_t epoch_ns;
+    uint64_t epoch_cycles;
+    uint64_t hz;
+
+    struct capture_buffer *buffers;
+    uint32_t nb_buffers;
+    struct rte_ring *free_ring;
+    struct rte_ring *full_ring;
+    struct capture_buffer *buf;  /* being filled, NULL if none */
+    uint64_t buf_ts;             /* when buf was taken */
+
+    uint32_t file_num;
+    uint64_t file_bytes;
+    uint64_t file_opened_ts;
+
+    struct capture_writer *writer;   /* NULL to write the buffers inline */
+    struct capture_files files;      /* written inline */
+
+    uint64_t captured_pkts;
+    uint64_t dropped_pkts;
+};
+
+/**
+ * Create the output and its first file, "<prefix>0.pcap"; id tells apart
+ * the DPDK objects of several outputs. With use_writer, a writer thread
+ * writes the files, with O_DIRECT if direct is set. Exits the application
+ * on failure.
+ */
+struct capture_output *capture_output_create(const std::string &prefix, uint32_t id,
+                                             uint64_t max_file_bytes,
+                                             uint32_t max_file_seconds,
+                                             bool use_writer, bool direct,
+                                             int socket_id);
+
+/* Write everything captured and close the files */
+void capture_output_close(struct capture_output *out);
+
+/**
+ * Capture a packet that arrived at arrival_ts (in timer cycles);
+ * the caller keeps ownership of mbuf
+ */
+void capture_output_add(struct capture_output *out, struct rte_mbuf *mbuf, uint64_t arrival_ts);
+
+/**
+ * Capture the first cap_len bytes of a packet of pkt_len bytes that
+ * arrived at arrival_ts (in timer cycles)
+ */
+void capture_output_add_data(struct capture_output *out, const uint8_t *data, uint32_t cap_len,
+                             uint32_t pkt_len, uint64_t arrival_ts);
+
+/**
+ * Housekeeping to run when the caller is about to wait: writes out the
+ * partial buffer if it is old enough, rotates the file if it is too old
+ * and, without a writer, opens the next file
+ */
+void capture_output_idle(struct capture_output *out);
+
+#endif /* CAPTURE_OUTPUT_H */
@@ -0,0 +1,283 @@
+#include "capture_writer.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rte_cycles.h>
+#include <rte_eal.h>
+
+/* Time the writer sleeps when it has nothing to do (in microseconds) */
+#define CAPTURE_WRITER_IDLE_US   (100u)
+
+/**
+ * Account for a finished write and give its buffer back
+ */
+static void capture_writer_finish(struct capture_writer *writer, uint32_t slot) {
+
+    struct capture_write *write = &writer->writes[slot];
+
+    uint64_t write_cycles = rte_get_timer_cycles() - write->submit_ts;
+    if (write_cycles > writer->max_write_cycles.load(std::memory_order_relaxed)) {
+        writer->max_write_cycles.store(write_cycles, std::memory_order_relaxed);
+    }
+    writer->written_bytes.fetch_add(write->done, std::memory_order_relaxed);
+
+    /* The free ring holds every buffer, so this cannot fail */
+    rte_ring_sp_enqueue(writer->free_ring, write->buf);
+
+    uint32_t nb_in_flight = writer->nb_in_flight.load(std::memory_order_relaxed) - 1;
+    writer->free_writes[CAPTURE_WRITER_DEPTH - 1 - nb_in_flight] = slot;
+    writer->nb_in_flight.store(nb_in_flight, std::memory_order_relaxed);
+}
+
+#ifdef HAVE_LIBURING
+
+static void capture_writer_queue(struct capture_writer *writer, uint32_t slot) {
+
+    struct capture_write *write = &writer->writes[slot];
+    struct io_uring_sqe *sqe = io_uring_get_sqe(&writer->uring);
+
+    /* The ring has an entry per write slot */
+    io_uring_prep_write(sqe, write->fd, write->buf->data + write->done, write->len,
+                        write->offset + write->done);
+    io_uring_sqe_set_data(sqe, (void *)(uintptr_t)slot);
+}
+
+/**
+ * Handle the completed writes; waits for one if wait is set
+ */
+static void capture_writer_reap(struct capture_writer *writer, bool wait) {
+
+    struct io_uring_cqe *cqe;
+    bool resubmit = false;
+
+    if (wait) {
+        if (io_uring_wait_cqe(&writer->uring, &cqe) < 0) {
+            return;
+        }
+    }
+    else if (io_uring_peek_cqe(&writer->uring, &cqe)) {
+        return;
+    }
+
+    do {
+        uint32_t slot = (uint32_t)(uintptr_t)io_uring_cqe_get_data(cqe);
+        struct capture_write *write = &writer->writes[slot];
+        int res = cqe->res;
+        io_uring_cqe_seen(&writer->uring, cqe);
+
+        if (res < 0) {
+            printf("Failed to write to capture file: %s\n", strerror(-res));
+            writer->failed_writes.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if (res == 0 || ((uint32_t)res < write->len && writer->files.direct)) {
+            /* No progress, or a rest that O_DIRECT cannot write at its unaligned offset */
+            printf("Failed to write to capture file: short write of %d bytes\n", res);
+            write->done += res;
+            writer->failed_writes.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if ((uint32_t)res < write->len) {
+            /* Short write: queue the rest */
+            write->done += res;
+            write->len -= res;
+            capture_writer_queue(writer, slot);
+            resubmit = true;
+            continue;
+        }
+        else {
+            write->done += res;
+        }
+        capture_writer_finish(writer, slot);
+    } while (!io_uring_peek_cqe(&writer->uring, &cqe));
+
+    if (resubmit) {
+        io_uring_submit(&writer->uring);
+    }
+}
+
+#else
+
+static void capture_writer_queue(struct capture_writer *writer, uint32_t slot) {
+
+    struct capture_write *write = &writer->writes[slot];
+
+    while (write->len) {
+        ssize_t res = pwrite(write->fd, write->buf->data + write->done, write->len,
+                             write->offset + write->done);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            printf("Failed to write to capture file: %s\n", strerror(errno));
+            writer->failed_writes.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        write->done += res;
+        write->len -= res;
+        if (write->len && (res == 0 || writer->files.direct)) {
+            /* No progress, or a rest that O_DIRECT cannot write at its unaligned offset */
+            printf("Failed to write to capture file: short write of %zd bytes\n", res);
+            writer->failed_writes.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+    capture_writer_finish(writer, slot);
+}
+
+static void capture_writer_reap(struct capture_writer *writer, bool wait) {
+    /* Writes complete as they are queued */
+    (void)writer;
+    (void)wait;
+}
+
+#endif
+
+/**
+ * Wait for every write in flight, e.g. before closing their file
+ */
+static void capture_writer_drain(struct capture_writer *writer) {
+#ifdef HAVE_LIBURING
+    io_uring_submit(&writer->uring);
+#endif
+    while (writer->nb_in_flight.load(std::memory_order_relaxed)) {
+        capture_writer_reap(writer, true);
+    }
+}
+
+/**
+ * Start writing a buffer at the end of its file
+ */
+static void capture_writer_write(struct capture_writer *writer, struct capture_buffer *buf) {
+
+    if (buf->file_num != writer->files.num) {
+        capture_writer_drain(writer);
+        capture_files_switch(&writer->files, buf->file_num);
+        printf("Writer: switched to capture file %u, queue depth %u (max %u), "
+               "longest write %" PRIu64 " us, stalled %" PRIu64 " ms\n",
+               buf->file_num, capture_writer_depth(writer),
+               writer->max_depth.load(std::memory_order_relaxed),
+               writer->max_write_cycles.load(std::memory_order_relaxed) * 1000000 / rte_get_timer_hz(),
+               writer->stall_cycles.load(std::memory_order_relaxed) * 1000 / rte_get_timer_hz());
+    }
+
+    uint32_t nb_in_flight = writer->nb_in_flight.load(std::memory_order_relaxed);
+    uint32_t slot = writer->free_writes[CAPTURE_WRITER_DEPTH - 1 - nb_in_flight];
+    writer->nb_in_flight.store(nb_in_flight + 1, std::memory_order_relaxed);
+
+    struct capture_write *write = &writer->writes[slot];
+    write->buf = buf;
+    write->fd = writer->files.fd;
+    write->offset = capture_files_append(&writer->files, buf->len, &write->len);
+    write->done = 0;
+    write->submit_ts = rte_get_timer_cycles();
+
+    capture_writer_queue(writer, slot);
+}
+
+static void capture_writer_loop(struct capture_writer *writer) {
+
+    struct capture_buffer *bufs[CAPTURE_WRITER_DEPTH];
+
+    while (1) {
+
+        capture_writer_reap(writer, false);
+
+        uint32_t nb_in_flight = writer->nb_in_flight.load(std::memory_order_relaxed);
+        uint32_t queued = rte_ring_count(writer->full_ring);
+        if (queued + nb_in_flight > writer->max_depth.load(std::memory_order_relaxed)) {
+            writer->max_depth.store(queued + nb_in_flight, std::memory_order_relaxed);
+        }
+
+        if (queued && nb_in_flight == CAPTURE_WRITER_DEPTH) {
+            /* Storage is the bottleneck */
+            uint64_t stall_ts = rte_get_timer_cycles();
+            capture_writer_reap(writer, true);
+            writer->stall_cycles.fetch_add(rte_get_timer_cycles() - stall_ts,
+                                           std::memory_order_relaxed);
+            continue;
+        }
+
+        uint32_t nb_bufs = rte_ring_sc_dequeue_burst(writer->full_ring, (void **)bufs,
+                                                     CAPTURE_WRITER_DEPTH - nb_in_flight, NULL);
+        for (uint32_t i = 0; i < nb_bufs; i++) {
+            capture_writer_write(writer, bufs[i]);
+        }
+#ifdef HAVE_LIBURING
+        if (nb_bufs) {
+            io_uring_submit(&writer->uring);
+        }
+#endif
+
+        if (nb_bufs == 0) {
+            if (nb_in_flight) {
+                capture_writer_reap(writer, true);
+            }
+            else if (writer->stop.load(std::memory_order_acquire)) {
+                /* Buffers queued before the stop are visible now */
+                if (rte_ring_empty(writer->full_ring)) {
+                    break;
+                }
+            }
+            else {
+                capture_files_prepare_next(&writer->files);
+                rte_delay_us_sleep(CAPTURE_WRITER_IDLE_US);
+            }
+        }
+    }
+}
+
+struct capture_writer *capture_writer_create(const std::string &prefix, bool direct,
+                                             struct rte_ring *full_ring,
+                                             struct rte_ring *free_ring) {
+
+    struct capture_writer *writer = new struct capture_writer;
+
+    writer->full_ring = full_ring;
+    writer->free_ring = free_ring;
+    capture_files_init(&writer->files, prefix, direct);
+
+#ifdef HAVE_LIBURING
+    int status = io_uring_queue_init(CAPTURE_WRITER_DEPTH, &writer->uring, 0);
+    if (status < 0) {
+        rte_exit(EXIT_FAILURE, "Cannot create the io_uring of the writer: %s\n",
+                 strerror(-status));
+    }
+#endif
+    for (uint32_t i = 0; i < CAPTURE_WRITER_DEPTH; i++) {
+        writer->free_writes[i] = i;
+    }
+    writer->nb_in_flight = 0;
+
+    writer->max_depth = 0;
+    writer->stall_cycles = 0;
+    writer->max_write_cycles = 0;
+    writer->written_bytes = 0;
+    writer->failed_writes = 0;
+
+    writer->stop = false;
+    writer->thread = std::thread(capture_writer_loop, writer);
+
+    return writer;
+}
+
+void capture_writer_stop(struct capture_writer *writer) {
+
+    writer->stop.store(true, std::memory_order_release);
+    writer->thread.join();
+
+#ifdef HAVE_LIBURING
+    io_uring_queue_exit(&writer->uring);
+#endif
+    capture_files_close(&writer->files);
+    printf("Writer: wrote %" PRIu64 " bytes, %" PRIu64 " failed writes\n",
+           writer->written_bytes.load(), writer->failed_writes.load());
+    delete writer;
+}
+
+uint32_t capture_writer_depth(struct capture_writer *writer) {
+    return rte_ring_count(writer->full_ring) +
+           writer->nb_in_flight.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,83 @@
+#ifndef CAPTURE_WRITER_H
+#define CAPTURE_WRITER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <rte_ring.h>
+
+#ifdef HAVE_LIBURING
+#include <liburing.h>
+#endif
+
+#include "capture_file.h"
+
+/* Number of buffer writes the writer keeps in flight */
+#define CAPTURE_WRITER_DEPTH     (8u)
+
+/* A buffer of formatted pcapng blocks, all for the same file */
+struct capture_buffer {
+    uint8_t *data;
+    uint32_t len;
+    uint32_t file_num;
+};
+
+/* A write in flight */
+struct capture_write {
+    struct capture_buffer *buf;
+    int fd;
+    uint64_t offset;
+    uint32_t len;                /* bytes left to write */
+    uint32_t done;
+    uint64_t submit_ts;
+};
+
+/**
+ * Storage writer thread
+ *
+ * Takes full buffers from an SPSC ring, writes them to the capture files
+ * and gives them back on another SPSC ring. With liburing, up to
+ * CAPTURE_WRITER_DEPTH writes are in flight through io_uring; without it,
+ * the buffers are written one at a time. Either way the lcore that fills
+ * the buffers never waits for the file system.
+ */
+struct capture_writer {
+    struct rte_ring *full_ring;  /* from the delay lcore */
+    struct rte_ring *free_ring;  /* back to the delay lcore */
+    struct capture_files files;
+
+#ifdef HAVE_LIBURING
+    struct io_uring uring;
+#endif
+    struct capture_write writes[CAPTURE_WRITER_DEPTH];
+    uint32_t free_writes[CAPTURE_WRITER_DEPTH];
+    std::atomic<uint32_t> nb_in_flight;
+
+    std::atomic<bool> stop;
+    std::thread thread;
+
+    /* Statistics, written by the writer thread only */
+    std::atomic<uint32_t> max_depth;         /* queued and in flight buffers */
+    std::atomic<uint64_t> stall_cycles;      /* waiting with every write slot busy */
+    std::atomic<uint64_t> max_write_cycles;
+    std::atomic<uint64_t> written_bytes;
+    std::atomic<uint64_t> failed_writes;
+};
+
+/**
+ * Start the writer thread. Buffers are written to "<prefix><num>.pcap",
+ * with O_DIRECT if direct is set. Exits the application on failure.
+ */
+struct capture_writer *capture_writer_create(const std::string &prefix, bool direct,
+                                             struct rte_ring *full_ring,
+                                             struct rte_ring *free_ring);
+
+/* Write every queued buffer, then stop the thread and close the files */
+void capture_writer_stop(struct capture_writer *writer);
+
+/* Number of buffers waiting to be written or being written */
+uint32_t capture_writer_depth(struct capture_writer *writer);
+
+#endif /* CAPTURE_WRITER_H */
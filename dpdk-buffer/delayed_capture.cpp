@@ -4,6 +4,7 @@
 
 #include <arpa/inet.h>
 #include <fcntl.h>
+#include <getopt.h>
 #include <inttypes.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -12,13 +13,8 @@
 #include <sys/types.h>
 #include <time.h>
 #include <unistd.h>
-#include <unordered_map>
 #include <vector>
-#include <fstream>
-#include <sstream>
-#include <iterator>
 #include <algorithm>
-#include <iostream>
 
 #include <rte_arp.h>
 #include <rte_byteorder.h>
@@ -26,11 +22,22 @@
 #include <rte_eal.h>
 #include <rte_ethdev.h>
 #include <rte_ether.h>
+#include <rte_flow.h>
 #include <rte_ip.h>
 #include <rte_launch.h>
 #include <rte_lcore.h>
 #include <rte_mbuf.h>
-#include <rte_pcapng.h>
+#include <rte_pause.h>
+#include <rte_ring.h>
+#include <rte_ring_peek.h>
+
+#include "capture_output.h"
+#include "prefix_map.h"
+#include "prefix_table.h"
+#include "rx_clock.h"
+#include "slot_ring.h"
+#include "state_feed.h"
+#include "state_table.h"
 
 
 /* Ethernet MTU size in bytes */
@@ -59,15 +66,31 @@
 //#define MBUF_POOL_SIZE              (8192)
 
 /**
- * Number of objects in the packet ring (between the first and second lcore)
+ * Number of objects in the packet memory pool in compact mode (--snaplen)
+ *
+ * The packets are copied into the slot rings as soon as they are received,
+ * so the pool only needs to cover the RX descriptors and the lcore caches.
+ */
+#define COMPACT_MBUF_POOL_SIZE   (1 << 16u)
+
+/* Per-lcore cache of the packet memory pool, shared by all RX lcores */
+#define MBUF_POOL_CACHE_SIZE     (256u)
+
+/**
+ * Number of objects in each packet ring (between an RX lcore and a delay lcore)
  *
  * This should be equal to the pool size limit.
  */
 #define MBUF_RING_SIZE           (MBUF_POOL_SIZE)
 
+/**
+ * Number of slots of the slot rings in compact mode, split between the RX
+ * lcores; it buffers as many packets as the pool does otherwise
+ */
+#define COMPACT_SLOTS            (MBUF_POOL_SIZE)
+
 /* TX/RX ring configuration */
 #define NB_TX_RINGS              (1)
-#define NB_RX_RINGS              (2)
 #define NB_TX_DESC               (1024)
 #define NB_RX_DESC               (1024)
 
@@ -96,9 +119,38 @@
 /* Time after which the state of the prefix can be updated (in seconds) from active to inactive*/
 #define BUFFER_STATE_UPDATE_TIME (3600u)
 
-/* Packet capture file name */
-#define PCAP_FILE_NAME           "packets."
-#define PCAP_FILE_EXT            ".pcap"
+/**
+ * With state feeds, number of controller epochs for which a control packet
+ * keeps its address active. By then an epoch that saw the activity has
+ * been published, and the feed tells whether the address is still active.
+ */
+#define FEED_ACTIVATION_EPOCHS   (2u)
+
+/**
+ * Time (in seconds) for which a prefix must stay active after a packet
+ * arrives for the packet to be dropped on arrival rather than buffered.
+ *
+ * A packet is discarded at its release if its prefix is active then. The
+ * release may come later than BUFFER_PACKETS_WAIT_TIME when the delay lcore
+ * is busy, hence the margin.
+ *
+ * Only the control packets bound the activity of a prefix in time. The state
+ * feeds only tell about the last published epoch, which may end before the
+ * release, so they are checked at the release alone.
+ */
+#define ADMISSION_HORIZON_TIME   (2 * BUFFER_PACKETS_WAIT_TIME)
+
+/**
+ * Time (in microseconds) by which a delay lcore wakes up before the
+ * deadline of the next packet when it sleeps, and polls from then on
+ */
+#define DELAY_SLEEP_SLACK_US     (100u)
+
+/* Default map of the monitored prefixes, written by the controller */
+#define PREFIX_MAP_FILE          "prefixes.bin"
+
+/* Default size (in MB) at which the packet capture file is rotated */
+#define CAPTURE_ROTATE_SIZE_MB   (1024u)
 
 /* Time when the packet arrived */
 struct __attribute__((aligned(RTE_MBUF_PRIV_ALIGN))) mbuf_priv_data {
@@ -107,20 +159,38 @@ struct __attribute__((aligned(RTE_MBUF_PRIV_ALIGN))) mbuf_priv_data {
 };
 
 
-/* Argument structure for the PCAP file */
-struct pcap_args {
-    int pcap_fd;
-    rte_pcapng_t *pcap_hdl;
-    struct rte_mempool *pcap_mbuf_pool;
-};
-
-/* Argument structure for the lcores */
-struct lcore_args {
+/* Argument structure for the RX lcores; aligned as each lcore updates its counters */
+struct __attribute__((aligned(RTE_CACHE_LINE_SIZE))) rx_lcore_args {
     uint16_t port_id;
-    uint32_t port_ip;
-    struct rte_mempool *mbuf_pool;
+    uint16_t queue_id;
+    int32_t ctl_queue_id;        /* -1 if this lcore serves no control queue */
     struct rte_ring *mbuf_ring;
-    struct pcap_args *pcap_args;
+    struct slot_ring *slot_ring; /* in compact mode, instead of mbuf_ring */
+    struct rx_clock clock;
+    uint64_t admission_cycles;   /* ADMISSION_HORIZON_TIME in timer cycles */
+    uint64_t nb_early_drops;     /* packets to active prefixes dropped on arrival */
+    uint64_t nb_full_drops;      /* packets dropped as the ring was full */
+};
+
+/* Argument structure for the delay lcores */
+struct delay_lcore_args {
+    std::vector<struct rte_ring *> mbuf_rings;
+    std::vector<struct slot_ring *> slot_rings;
+    struct capture_output *capture;
+};
+
+/* Optional arguments of the application */
+struct app_options {
+    std::string capture_prefix;
+    uint64_t rotate_size_mb;
+    uint32_t rotate_time;
+    bool writer;
+    bool direct_io;
+    uint32_t rx_lcores;          /* 0 for half of the lcores */
+    uint32_t snaplen;            /* 0 to buffer the whole mbufs */
+    bool hw_timestamps;
+    std::vector<std::string> prefix_maps;
+    std::vector<std::string> state_feeds;    /* none, or one per prefix map */
 };
 
 /**
@@ -134,53 +204,103 @@ struct __attribute__((packed)) ip6_payload {
 };
 
 /**
- * Global array. This is application specific.
+ * State of the monitored prefixes. This is application specific.
+ *
+ * Written by the lcores receiving control packets, read by the delay lcores.
  */
-std::vector<bool> g_state_arr;
-std::vector<uint64_t> g_state_last_changed_ts;
+struct state_table *g_state_table;
 
 /**
 * Mapping of IPv4 addresses to indices
 */
-std::unordered_map<uint32_t, int> ip_to_idx;
+struct prefix_table *ip_table;
+
+/**
+ * A monitored IPv6 prefix; only the upper 64 bits of the addresses count
+ */
+struct ipv6_range {
+    uint64_t addr;               /* host byte order */
+    uint64_t mask;
+    uint32_t shift;              /* log2 of the addresses per index */
+    uint32_t base_idx;
+};
 
 /**
-* Mapping of IPv6 addresses to indices
+* Mapping of IPv6 addresses to indices, longest prefix first
 */
-std::unordered_map<uint64_t, int> ipv6_to_idx; // we will never go beyond /64
+std::vector<struct ipv6_range> ipv6_ranges;
+
+/**
+ * Activity state published by the controllers, one feed per prefix map
+ */
+std::vector<struct state_feed> g_state_feeds;
+
+/**
+ * Restrict RSS to the first nb_rss_queues RX queues, leaving the other
+ * queues to the packets steered there by flow rules
+ */
+static int restrict_rss(uint16_t port_id, uint16_t reta_size, uint16_t nb_rss_queues) {
+
+    std::vector<struct rte_eth_rss_reta_entry64> reta_conf(
+        RTE_ALIGN_CEIL(reta_size, RTE_ETH_RETA_GROUP_SIZE) / RTE_ETH_RETA_GROUP_SIZE);
+
+    memset(reta_conf.data(), 0, reta_conf.size() * sizeof(struct rte_eth_rss_reta_entry64));
+    for (uint16_t i = 0; i < reta_size; i++) {
+        reta_conf[i / RTE_ETH_RETA_GROUP_SIZE].mask |= 1ULL << (i % RTE_ETH_RETA_GROUP_SIZE);
+        reta_conf[i / RTE_ETH_RETA_GROUP_SIZE].reta[i % RTE_ETH_RETA_GROUP_SIZE] = i % nb_rss_queues;
+    }
+    return rte_eth_dev_rss_reta_update(port_id, reta_conf.data(), reta_size);
+}
 
 /**
  * Initialize the given ethernet port
+ *
+ * RSS spreads the traffic over the first nb_rss_queues RX queues only; the
+ * remaining ones receive what flow rules steer to them.
  */
-int port_init(uint16_t port_id, struct rte_mempool *mbuf_pool) {
+int port_init(uint16_t port_id, struct rte_mempool *mbuf_pool, uint16_t nb_rx_queues,
+              uint16_t nb_rss_queues, uint64_t rx_offloads) {
 
     int status;
     struct rte_eth_conf port_conf;
+    struct rte_eth_dev_info dev_info;
 
     /* Check if the port ID is valid */
     if (!rte_eth_dev_is_valid_port(port_id)) {
         return -1;
     }
 
-    /* Configure the port */
-    memset(&port_conf, 0, sizeof(struct rte_eth_conf));
-    status = rte_eth_dev_configure(port_id, NB_RX_RINGS, NB_TX_RINGS, &port_conf);
+    status = rte_eth_dev_info_get(port_id, &dev_info);
     if (status) {
         return status;
     }
+    if (nb_rx_queues > dev_info.max_rx_queues) {
+        printf("Port %d has only %d RX queues\n", port_id, dev_info.max_rx_queues);
+        return -1;
+    }
 
-    /* Configure the RX queue */
-    status = rte_eth_rx_queue_setup(port_id, 0, NB_RX_DESC,
-                                    rte_eth_dev_socket_id(port_id), NULL, mbuf_pool);
-    if (status) {
-        return status;
+    /* Configure the port; RSS spreads the packets over the RX queues */
+    memset(&port_conf, 0, sizeof(struct rte_eth_conf));
+    port_conf.rxmode.offloads = rx_offloads;
+    if (nb_rss_queues > 1) {
+        port_conf.rxmode.mq_mode = RTE_ETH_MQ_RX_RSS;
+        port_conf.rx_adv_conf.rss_conf.rss_key = NULL;
+        port_conf.rx_adv_conf.rss_conf.rss_hf = RTE_ETH_RSS_IP & dev_info.flow_type_rss_offloads;
     }
-    status = rte_eth_rx_queue_setup(port_id, 1, NB_RX_DESC,
-                                    rte_eth_dev_socket_id(port_id), NULL, mbuf_pool);
+    status = rte_eth_dev_configure(port_id, nb_rx_queues, NB_TX_RINGS, &port_conf);
     if (status) {
         return status;
     }
 
+    /* Configure the RX queues */
+    for (uint16_t queue_id = 0; queue_id < nb_rx_queues; queue_id++) {
+        status = rte_eth_rx_queue_setup(port_id, queue_id, NB_RX_DESC,
+                                        rte_eth_dev_socket_id(port_id), NULL, mbuf_pool);
+        if (status) {
+            return status;
+        }
+    }
+
     /* Configure the TX queue */
     status = rte_eth_tx_queue_setup(port_id, 0, NB_TX_DESC,
                                     rte_eth_dev_socket_id(port_id), NULL);
@@ -207,16 +327,82 @@ int port_init(uint16_t port_id, struct rte_mempool *mbuf_pool) {
     }
     printf("Enabled promiscuous mode for port %d\n", port_id);
 
+    /* Not fatal: whatever RSS puts on the other queues is still received */
+    if (nb_rss_queues > 1 && nb_rss_queues < nb_rx_queues) {
+        if (dev_info.reta_size == 0 || restrict_rss(port_id, dev_info.reta_size, nb_rss_queues)) {
+            printf("Cannot restrict RSS to %d RX queues on port %d\n", nb_rss_queues, port_id);
+        }
+    }
 
     return 0;
 }
 
+/**
+ * Steer the IPv4 or IPv6 control packets to the given RX queue
+ */
+static struct rte_flow *steer_ctl_packets(uint16_t port_id, uint16_t queue_id, bool is_ipv6) {
+
+    struct rte_flow_attr attr;
+    struct rte_flow_item pattern[3];
+    struct rte_flow_action actions[2];
+    struct rte_flow_item_ipv4 ip_spec, ip_mask;
+    struct rte_flow_item_ipv6 ip6_spec, ip6_mask;
+    struct rte_flow_action_queue queue;
+    struct rte_flow_error error;
+
+    memset(&attr, 0, sizeof(struct rte_flow_attr));
+    attr.ingress = 1;
+
+    /* Match any Ethernet frame carrying an IP packet of the control protocol */
+    memset(pattern, 0, sizeof(pattern));
+    pattern[0].type = RTE_FLOW_ITEM_TYPE_ETH;
+    if (is_ipv6) {
+        memset(&ip6_spec, 0, sizeof(struct rte_flow_item_ipv6));
+        memset(&ip6_mask, 0, sizeof(struct rte_flow_item_ipv6));
+        ip6_spec.hdr.proto = CTL_IP_PROTO;
+        ip6_mask.hdr.proto = 0xff;
+        pattern[1].type = RTE_FLOW_ITEM_TYPE_IPV6;
+        pattern[1].spec = &ip6_spec;
+        pattern[1].mask = &ip6_mask;
+    }
+    else {
+        memset(&ip_spec, 0, sizeof(struct rte_flow_item_ipv4));
+        memset(&ip_mask, 0, sizeof(struct rte_flow_item_ipv4));
+        ip_spec.hdr.next_proto_id = CTL_IP_PROTO;
+        ip_mask.hdr.next_proto_id = 0xff;
+        pattern[1].type = RTE_FLOW_ITEM_TYPE_IPV4;
+        pattern[1].spec = &ip_spec;
+        pattern[1].mask = &ip_mask;
+    }
+    pattern[2].type = RTE_FLOW_ITEM_TYPE_END;
+
+    memset(actions, 0, sizeof(actions));
+    queue.index = queue_id;
+    actions[0].type = RTE_FLOW_ACTION_TYPE_QUEUE;
+    actions[0].conf = &queue;
+    actions[1].type = RTE_FLOW_ACTION_TYPE_END;
+
+    if (rte_flow_validate(port_id, &attr, pattern, actions, &error) == 0) {
+        struct rte_flow *flow = rte_flow_create(port_id, &attr, pattern, actions, &error);
+        if (flow) {
+            return flow;
+        }
+    }
+    printf("Cannot steer the IPv%d control packets on port %d: %s\n", is_ipv6 ? 6 : 4,
+           port_id, error.message ? error.message : "unknown error");
+    return NULL;
+}
+
 /**
  * De-initialize the given ethernet port
  */
 int port_deinit(uint16_t port_id) {
 
     int status;
+    struct rte_flow_error error;
+
+    /* Remove the flow rules */
+    rte_flow_flush(port_id, &error);
 
     /* Stop the port */
     status = rte_eth_dev_stop(port_id);
@@ -234,127 +420,100 @@ int port_deinit(uint16_t port_id) {
 }
 
 /**
-* Convert IPv4 address to integer
-*/
-
-uint32_t IPv4ToInt(const std::string& ip) {
-    uint32_t result = 0;
-    std::stringstream ss(ip);
-    std::string ip_byte;
-
-    for (int i = 3; i >= 0; --i) {
-        getline(ss, ip_byte, '.');
-        result |= (stoi(ip_byte) << (i * 8));
+ * Read the maps of the monitored prefixes to indices written by the
+ * controllers. The indices of each map follow those of the previous ones.
+ * If feed_names is not empty, it names the state feed of each map.
+ */
+void read_mapping(const std::vector<std::string> &paths, const std::vector<std::string> &feed_names) {
+    struct prefix_map map;
+    std::vector<struct prefix_range> ipv4_ranges;
+    uint32_t ipv4_unit_len = 0;
+    uint64_t nb_indices = 0;
+    uint32_t feed_interval_ms = 0;
+
+    if (!feed_names.empty() && feed_names.size() != paths.size()) {
+        rte_exit(EXIT_FAILURE, "Need one state feed per prefix map\n");
     }
-    return result;
-}
 
-/**
-* Convert IPv6 address to bytes
-*/
-
-uint64_t IPv6To64Int(const std::string& ip) {
-    uint8_t bytes[16];
-    memset(bytes, 0, 16);
-    std::istringstream ss(ip);
-    std::string part;
-    int index = 0;
-    uint16_t value;
-    uint64_t block_64 = 0;
-
-    while (getline(ss, part, ':')) {
-        if (part.empty()) {
-            // Handle "::" by skipping to the appropriate position
-            index += (8 - std::count_if(std::istream_iterator<std::string>(ss),
-                                        std::istream_iterator<std::string>(),
-                                        [](const std::string&) { return true; })) * 2;
-            continue;
+    for (const std::string &path : paths) {
+        if (prefix_map_open(&map, path.c_str())) {
+            rte_exit(EXIT_FAILURE, "Cannot read the prefix map %s\n", path.c_str());
         }
-        value = stoi(part, nullptr, 16);
-        bytes[index++] = (value >> 8) & 0xFF; // High byte
-        bytes[index++] = value & 0xFF;       // Low byte
-    }
 
-    // get the 64 bit block to use as key
-    for (int i = 0; i < 8; i++) {
-        block_64 |= bytes[i] << (i * 8);
-    }
+        uint64_t map_indices = 0;
+        for (uint32_t i = 0; i < map.nb_records; i++) {
+            const struct prefix_map_record *record = &map.records[i];
+            uint64_t base_idx = nb_indices + record->base_idx;
+            map_indices = RTE_MAX(map_indices, record->base_idx + prefix_map_record_indices(record));
 
-    return block_64;
-}
+            if (record->family == 4) {
+                /* The IPv4 table has one block size, within a /24 */
+                if ((ipv4_unit_len && record->unit_len != ipv4_unit_len) || record->unit_len < 24) {
+                    rte_exit(EXIT_FAILURE, "Unsupported index unit /%u for IPv4\n", record->unit_len);
+                }
+                ipv4_unit_len = record->unit_len;
 
-/**
-* Read mapping of addresses to indices from a file
-*/
-void read_mapping(const char* filename) {
-    std::ifstream file(filename);
-    std::string line;
-    int idx = 0;
-
-    while (getline(file, line)) {
-        // check if it is an IPv4 or IPv6 address
-        if (line.find(':') != std::string::npos) {
-            uint64_t ip6 = IPv6To64Int(line);
-            ipv6_to_idx[ip6] = idx;
-        } else {
-            uint32_t int_ipv4 = IPv4ToInt(line);
-            ip_to_idx[int_ipv4] = idx;
+                struct prefix_range range;
+                range.addr = rte_be_to_cpu_32(*(const uint32_t *)record->addr);
+                range.len = record->prefix_len;
+                range.base_idx = base_idx;
+                ipv4_ranges.push_back(range);
+            }
+            else {
+                struct ipv6_range range;
+                uint64_t addr;
+                memcpy(&addr, record->addr, sizeof(uint64_t));
+                range.mask = record->prefix_len ? ~0ull << (64 - record->prefix_len) : 0;
+                range.addr = rte_be_to_cpu_64(addr) & range.mask;
+                range.shift = 64 - record->unit_len;
+                range.base_idx = base_idx;
+                ipv6_ranges.push_back(range);
+            }
         }
-        idx++;
+        printf("Read %u prefixes and %" PRIu64 " indices from %s\n",
+               map.nb_records, map_indices, path.c_str());
+        prefix_map_close(&map);
+        if (nb_indices + map_indices > PREFIX_ENTRY_VALUE_MASK) {
+            rte_exit(EXIT_FAILURE, "Too many monitored addresses\n");
+        }
+
+        if (!feed_names.empty()) {
+            const char *name = feed_names[g_state_feeds.size()].c_str();
+            struct state_feed feed;
+            if (state_feed_open(&feed, name, nb_indices, map_indices)) {
+                rte_exit(EXIT_FAILURE, "Cannot attach the state feed %s\n", name);
+            }
+            printf("Attached the state feed %s, epochs of %u ms\n", name, feed.header->interval_ms);
+            feed_interval_ms = RTE_MAX(feed_interval_ms, feed.header->interval_ms);
+            g_state_feeds.push_back(feed);
+        }
+        nb_indices += map_indices;
     }
-    g_state_arr.resize(idx, false);
-    g_state_last_changed_ts.resize(idx, 0);
-    printf("Read %d prefixes from the file\n", idx);
-}
 
-/**
-* Initialize the PCAP file
-*/
-struct pcap_args *pcap_init(const char* filename, uint16_t port_id) {
-    int pcap_fd;
-    rte_pcapng_t *pcap_hdl;
-    struct rte_mempool *pcap_mbuf_pool;
-    struct pcap_args *file_args = new struct pcap_args;
-
-    /* Setup the packet capture files and required resources */
-    pcap_fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
-    if (pcap_fd < 0) {
-        rte_exit(EXIT_FAILURE, "Failed to create the packet capture file %s",
-                 filename);
-    }
-    pcap_hdl = rte_pcapng_fdopen(pcap_fd, NULL, NULL, NULL, NULL);
-    if (!pcap_hdl) {
-        rte_exit(EXIT_FAILURE, "Failed to create the DPDK packet capture handle");
+    ip_table = prefix_table_create(ipv4_ranges, ipv4_unit_len ? 32 - ipv4_unit_len : 0,
+                                   rte_socket_id());
+    if (!ip_table) {
+        rte_exit(EXIT_FAILURE, "Cannot create the IPv4 prefix table\n");
     }
-    
-    pcap_mbuf_pool = rte_pktmbuf_pool_create("PCAP_MBUF_POOL", 2048,
-                                             0, 0,
-                                             rte_pcapng_mbuf_size(RTE_MBUF_DEFAULT_BUF_SIZE),
-                                             rte_socket_id());
-    if (!pcap_mbuf_pool) {
-        rte_exit(EXIT_FAILURE, "Cannot create PCAP mbuf pool\n");
+    printf("Built the IPv4 prefix table: %u direct /24s, %u tbl8 groups\n",
+           ip_table->nb_direct, ip_table->nb_tbl8_groups);
+
+    /* Longest prefix first, as in the data plane */
+    std::stable_sort(ipv6_ranges.begin(), ipv6_ranges.end(),
+                     [](const struct ipv6_range &a, const struct ipv6_range &b) {
+                         return a.mask > b.mask;
+                     });
+
+    /* The feeds say when the addresses turn inactive */
+    uint64_t expiry_cycles = BUFFER_STATE_UPDATE_TIME * rte_get_timer_hz();
+    if (!g_state_feeds.empty()) {
+        expiry_cycles = (uint64_t)FEED_ACTIVATION_EPOCHS * feed_interval_ms * rte_get_timer_hz() / 1000;
     }
-
-    if (rte_pcapng_add_interface(pcap_hdl, port_id, NULL, NULL, NULL) < 0) {
-        rte_exit(EXIT_FAILURE, "Failed to add port %d to the DPDK "
-                 "packet capture handle", port_id);
+    g_state_table = state_table_create(nb_indices, expiry_cycles, rte_socket_id());
+    if (!g_state_table) {
+        rte_exit(EXIT_FAILURE, "Cannot create the prefix state table\n");
     }
-    file_args->pcap_fd = pcap_fd;
-    file_args->pcap_hdl = pcap_hdl;
-    file_args->pcap_mbuf_pool = pcap_mbuf_pool;
-
-    return file_args;
-}
-
-/**
-* Perform the PCAP-specific cleanup
-*/
-
-void close_pcap_file(struct pcap_args *file_args) {
-    rte_pcapng_close(file_args->pcap_hdl);
-    rte_mempool_free(file_args->pcap_mbuf_pool);
-    close(file_args->pcap_fd);
-    delete file_args;
+    printf("Monitoring %" PRIu64 " indices\n", nb_indices);
 }
 
 /**
@@ -370,16 +529,10 @@ int get_arr_idx_from_ip_packet(struct rte_ipv4_hdr *ip_hdr, bool is_not_normal)
     else {
         /* Typecast data as required to extract the array index */
         struct ip_payload *payload = (struct ip_payload *)((char *)ip_hdr + ip_hdr_len);
-        int_addr = payload->target_ip;
+        int_addr = rte_be_to_cpu_32(payload->target_ip);
     }
 
-    printf("payload->target_ip: %u\n", int_addr);
-    if (ip_to_idx.find(int_addr) == ip_to_idx.end()) {
-        return -1;
-    }
-    else {
-        return ip_to_idx[int_addr];
-    }
+    return prefix_table_lookup(ip_table, int_addr);
 }
 
 int get_arr_idx_from_ip6_packet(struct rte_ipv6_hdr *ip6_hdr, bool is_not_normal) {
@@ -395,161 +548,413 @@ int get_arr_idx_from_ip6_packet(struct rte_ipv6_hdr *ip6_hdr, bool is_not_normal
         memcpy(int_addr, payload->target_ip, 16);
     }
     
-    // get the /64 block to use as key
-    // by default it is /56, so we zero out the last 8 bits of the 8th byte
-    int_addr[7] &= 0xF0; // zero out last 4 bits
-    uint64_t block_64 = 0;
-    for (int i = 0; i < 8; i++) {
-        block_64 |= int_addr[i] << (i * 8);
+    /* The few monitored prefixes are scanned, longest first */
+    uint64_t block_64;
+    memcpy(&block_64, int_addr, sizeof(uint64_t));
+    block_64 = rte_be_to_cpu_64(block_64);
+    for (const struct ipv6_range &range : ipv6_ranges) {
+        if ((block_64 & range.mask) == range.addr) {
+            return range.base_idx + ((block_64 - range.addr) >> range.shift);
+        }
     }
-    
-    if (ipv6_to_idx.find(block_64) == ipv6_to_idx.end()) {
-        return -1;
+    return -1;
+}
+
+/**
+ * Check if the address at arr_idx was active in the last epoch published
+ * by its controller; false without state feeds
+ */
+static inline bool feed_is_active(uint32_t arr_idx) {
+    for (const struct state_feed &feed : g_state_feeds) {
+        if (state_feed_covers(&feed, arr_idx)) {
+            return state_feed_is_active(&feed, arr_idx);
+        }
+    }
+    return false;
+}
+
+/* The same for a burst of addresses, see state_table_query_bulk() */
+static inline void address_query_bulk(const uint32_t *arr_idx, uint32_t nb_indices, uint64_t ts,
+                                      bool *active) {
+    state_table_query_bulk(g_state_table, arr_idx, nb_indices, ts, active);
+    if (!g_state_feeds.empty()) {
+        for (uint32_t i = 0; i < nb_indices; i++) {
+            active[i] = active[i] || feed_is_active(arr_idx[i]);
+        }
+    }
+}
+
+/**
+ * Wait until the given TSC deadline.
+ *
+ * Sleeps for most of the wait when it is long enough and polls the rest,
+ * since sleeping overshoots its target by tens of microseconds.
+ */
+static void wait_until(uint64_t deadline) {
+
+    uint64_t curr_ts = rte_get_timer_cycles();
+    if (curr_ts >= deadline) {
+        return;
+    }
+
+    uint64_t wait_us = (deadline - curr_ts) * 1000000 / rte_get_timer_hz();
+    if (wait_us > 2 * DELAY_SLEEP_SLACK_US) {
+        rte_delay_us_sleep(wait_us - DELAY_SLEEP_SLACK_US);
+    }
+    while (rte_get_timer_cycles() < deadline) {
+        rte_pause();
+    }
+}
+
+/**
+ * Whether a packet has been buffered for wait_cycles. The age is signed,
+ * so a packet an RX lcore stamped after curr_ts was read has not expired
+ * rather than wrapping around to a huge age.
+ */
+static inline bool packet_expired(uint64_t arrival_ts, uint64_t curr_ts, uint64_t wait_cycles) {
+    return (int64_t)(curr_ts - arrival_ts) >= (int64_t)wait_cycles;
+}
+
+/**
+ * Release the expired packets at the head of a packet ring.
+ *
+ * The ring is in arrival order, so the packet at its head expires first.
+ * This peeks a burst at the head, takes out only the expired prefix of it
+ * and leaves the rest in the ring, reading the timer after the peek. If
+ * nothing has expired, next_deadline is lowered to the deadline of the
+ * head packet.
+ *
+ * Returns the number of released packets.
+ */
+static uint32_t release_expired(struct rte_ring *mbuf_ring, struct capture_output *capture,
+                                uint64_t wait_cycles, uint64_t *next_deadline) {
+
+    struct rte_mbuf *mbufs[BURST_SIZE];
+    uint32_t arr_idx[BURST_SIZE];
+    bool active[BURST_SIZE];
+    uint32_t nb_peeked;
+    uint32_t nb_expired;
+
+    struct mbuf_priv_data *pdata;
+    struct rte_ipv4_hdr *ip_hdr;
+    struct rte_ipv6_hdr *ip6_hdr;
+
+    /* Look at the packets at the head of the ring without removing them */
+    nb_peeked = rte_ring_dequeue_burst_start(mbuf_ring, (void **)mbufs, BURST_SIZE, NULL);
+    if (nb_peeked == 0) {
+        rte_ring_dequeue_finish(mbuf_ring, 0);
+        return 0;
+    }
+    uint64_t curr_ts = rte_get_timer_cycles();
+
+    /* Count the expired packets; the burst is sorted by arrival time */
+    nb_expired = 0;
+    pdata = (struct mbuf_priv_data *)rte_mbuf_to_priv(mbufs[nb_peeked - 1]);
+    if (packet_expired(pdata->arrival_ts, curr_ts, wait_cycles)) {
+        nb_expired = nb_peeked;
     }
     else {
-        return ipv6_to_idx[block_64];
+        while (nb_expired < nb_peeked) {
+            pdata = (struct mbuf_priv_data *)rte_mbuf_to_priv(mbufs[nb_expired]);
+            if (!packet_expired(pdata->arrival_ts, curr_ts, wait_cycles)) {
+                break;
+            }
+            nb_expired++;
+        }
+    }
+
+    /* Leave the packets that have not expired in the ring */
+    rte_ring_dequeue_finish(mbuf_ring, nb_expired);
+
+    if (nb_expired == 0) {
+        pdata = (struct mbuf_priv_data *)rte_mbuf_to_priv(mbufs[0]);
+        *next_deadline = RTE_MIN(*next_deadline, pdata->arrival_ts + wait_cycles);
+        return 0;
+    }
+
+    /* Get the prefixes of the expired packets; only monitored ones were enqueued */
+    for (uint32_t i = 0; i < nb_expired; i++) {
+        pdata = (struct mbuf_priv_data *)rte_mbuf_to_priv(mbufs[i]);
+        if (!pdata->is_ipv6){
+            ip_hdr = rte_pktmbuf_mtod_offset(mbufs[i], struct rte_ipv4_hdr *,
+                                             sizeof(struct rte_ether_hdr));
+            arr_idx[i] = get_arr_idx_from_ip_packet(ip_hdr, false);
+        }
+        else{
+            ip6_hdr = rte_pktmbuf_mtod_offset(mbufs[i], struct rte_ipv6_hdr *,
+                                              sizeof(struct rte_ether_hdr));
+            arr_idx[i] = get_arr_idx_from_ip6_packet(ip6_hdr, false);
+        }
+    }
+    address_query_bulk(arr_idx, nb_expired, curr_ts, active);
+
+    /* Store the packets only if the state of their prefix is inactive */
+    for (uint32_t i = 0; i < nb_expired; i++) {
+        if (!active[i]) {
+            pdata = (struct mbuf_priv_data *)rte_mbuf_to_priv(mbufs[i]);
+            capture_output_add(capture, mbufs[i], pdata->arrival_ts);
+        }
     }
+
+    /* Free the packets */
+    rte_pktmbuf_free_bulk(mbufs, nb_expired);
+
+    return nb_expired;
 }
 
+/**
+ * Release the expired packets at the head of a slot ring, like
+ * release_expired() does for the mbuf rings.
+ *
+ * Returns the number of released packets.
+ */
+static uint32_t release_expired_slots(struct slot_ring *slot_ring, struct capture_output *capture,
+                                      uint64_t wait_cycles, uint64_t *next_deadline) {
+
+    struct packet_slot *slots[BURST_SIZE];
+    uint32_t arr_idx[BURST_SIZE];
+    bool active[BURST_SIZE];
+    uint32_t nb_ready;
+    uint32_t nb_expired;
+
+    nb_ready = RTE_MIN(slot_ring_count(slot_ring), (uint32_t)BURST_SIZE);
+    uint64_t curr_ts = rte_get_timer_cycles();
+
+    /* Collect the expired packets; the ring is sorted by arrival time */
+    nb_expired = 0;
+    while (nb_expired < nb_ready) {
+        slots[nb_expired] = slot_ring_peek(slot_ring, nb_expired);
+        if (!packet_expired(slots[nb_expired]->arrival_ts, curr_ts, wait_cycles)) {
+            break;
+        }
+        arr_idx[nb_expired] = slots[nb_expired]->arr_idx;
+        nb_expired++;
+    }
+
+    if (nb_expired == 0) {
+        if (nb_ready) {
+            *next_deadline = RTE_MIN(*next_deadline, slots[0]->arrival_ts + wait_cycles);
+        }
+        return 0;
+    }
+
+    /* Store the packets only if the state of their prefix is inactive */
+    address_query_bulk(arr_idx, nb_expired, curr_ts, active);
+    for (uint32_t i = 0; i < nb_expired; i++) {
+        if (!active[i]) {
+            capture_output_add_data(capture, slots[i]->data, slots[i]->cap_len,
+                                    slots[i]->pkt_len, slots[i]->arrival_ts);
+        }
+    }
+
+    /* Give the slots back to the RX lcore */
+    slot_ring_pop(slot_ring, nb_expired);
+
+    return nb_expired;
+}
 
 /**
- * Loop to run on the second lcore.
+ * Loop to run on the delay lcores.
  *
- * This loop receives packets from the first lcore. It will process the packets
- * only after the packets sent by the first lcore were buffered for some
+ * This loop receives packets from one or more RX lcores, each over its own
+ * ring. It will process the packets only after they were buffered for some
  * fixed amount of time (say 1 second).
  *
+ * When no ring has expired packets, it waits for the earliest deadline of
+ * the packets at their heads, or for a full buffer time if every ring is
+ * empty, since any packet arriving later expires later.
  */
 int second_half_loop(void *_args) {
 
-    int status;
-
-    struct lcore_args *args = (struct lcore_args *)_args;
+    struct delay_lcore_args *args = (struct delay_lcore_args *)_args;
 
-    uint16_t port_id = args->port_id;
-    struct rte_mempool *mbuf_pool = args->mbuf_pool;
-    struct rte_ring *mbuf_ring = args->mbuf_ring;
-    struct pcap_args *pcap_args = args->pcap_args;
+    std::vector<struct rte_ring *> &mbuf_rings = args->mbuf_rings;
+    std::vector<struct slot_ring *> &slot_rings = args->slot_rings;
+    struct capture_output *capture = args->capture;
 
-    struct rte_mbuf *mbuf;
-    uint64_t curr_ts;
-    uint64_t arrival_ts;
-    bool is_ipv6;
-    int arr_idx;
-    int captured_pkts = 0;
-    int pcap_num = 1;
-
-    struct rte_ipv4_hdr *ip_hdr;
-    struct rte_ipv6_hdr *ip6_hdr;
+    uint32_t nb_released;
+    uint64_t next_deadline;
+    uint64_t wait_cycles = BUFFER_PACKETS_WAIT_TIME * rte_get_timer_hz();
 
     while (1) {
 
-        /* Wait till there are any elements in the ring */
-        if (rte_ring_empty(mbuf_ring)) {
-            continue;
+        next_deadline = rte_get_timer_cycles() + wait_cycles;
+
+        nb_released = 0;
+        for (struct rte_ring *mbuf_ring : mbuf_rings) {
+            nb_released += release_expired(mbuf_ring, capture, wait_cycles, &next_deadline);
+        }
+        for (struct slot_ring *slot_ring : slot_rings) {
+            nb_released += release_expired_slots(slot_ring, capture, wait_cycles, &next_deadline);
         }
 
-        /* Get an object from the ring */
-        status = rte_ring_dequeue(mbuf_ring, (void **)&mbuf);
-        if (status) {
-            continue;
+        if (nb_released == 0) {
+            capture_output_idle(capture);
+            wait_until(next_deadline);
         }
+    }
 
-        /* Get the packet's arrival time in the ring */
-        struct mbuf_priv_data *pdata = (struct mbuf_priv_data*) rte_mbuf_to_priv(mbuf);
-        arrival_ts = pdata->arrival_ts;
-        is_ipv6 = pdata->is_ipv6;
+    return 0;
+}
 
-        /* Get the current time */
-        curr_ts = rte_get_timer_cycles();
+/**
+ * Pass a packet to the delay lcore, as it is or copied into a slot
+ */
+static void buffer_packet(struct rte_mbuf *mbuf, uint32_t arr_idx, uint64_t arrival_ts,
+                          struct rx_lcore_args *args) {
 
-        /* Check if the object has exceeded the buffer time threshold */
-        while ((curr_ts - arrival_ts) <
-               (BUFFER_PACKETS_WAIT_TIME * rte_get_timer_hz())) {
-            /**
-             * We can be smart here and probably sleep here, instead
-             * of busy polling. Check rte_delay_us_sleep(). But
-             * no need to have that level of complexity here.
-             */
-            curr_ts = rte_get_timer_cycles();
+    if (args->slot_ring) {
+        if (unlikely(!slot_ring_push(args->slot_ring, mbuf, arrival_ts, arr_idx))) {
+            args->nb_full_drops++;
         }
+        rte_pktmbuf_free(mbuf);
+    }
+    else if (unlikely(rte_ring_enqueue(args->mbuf_ring, mbuf))) {
+        rte_pktmbuf_free(mbuf);
+        args->nb_full_drops++;
+    }
+}
+
+/**
+ * Handle a received packet.
+ *
+ * Control packets update the state of their prefix. Other packets to a
+ * monitored prefix are passed to the delay lcore through its ring,
+ * unless the prefix is sure to be still active at their release; the rest
+ * are dropped. rx_ts is the time the packet's burst was received.
+ */
+static void process_packet(struct rte_mbuf *mbuf, struct rx_lcore_args *args, uint64_t rx_ts) {
+
+    struct rte_ether_hdr *eth_hdr;
+    struct rte_ipv4_hdr *ip_hdr;
+    struct rte_ipv6_hdr *ip6_hdr;
+    uint16_t ether_type;
+
+    /* Get the type of ethernet packet */
+    eth_hdr = rte_pktmbuf_mtod(mbuf, struct rte_ether_hdr *);
+    ether_type = rte_be_to_cpu_16(eth_hdr->ether_type);
+    
+    // NO NEED FOR ARP, ONLY IPV4 AND IPV6 ARE SHOULD BE RECEIVED AND PROCESSED;
+    // WE DO NOT HAVE/NEED AN IP ADDR ON OUR END
+    if (ether_type == RTE_ETHER_TYPE_IPV4) {
 
-        /* Process the packet */
-        if (!is_ipv6){
-            ip_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv4_hdr *,
+        /* Get the IP header */
+        ip_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv4_hdr *,
                                          sizeof(struct rte_ether_hdr));
-            arr_idx = get_arr_idx_from_ip_packet(ip_hdr, false);
+        
+        if (ip_hdr->next_proto_id != CTL_IP_PROTO) {
+            /* Set the arrival time in the packet */
+            struct mbuf_priv_data *pdata = (struct mbuf_priv_data*) rte_mbuf_to_priv(mbuf);
+            pdata->arrival_ts = rx_clock_arrival(&args->clock, mbuf, rx_ts);
+            pdata->is_ipv6 = false;
+
+            int arr_idx = get_arr_idx_from_ip_packet(ip_hdr, false);
+            if (arr_idx == -1) {
+                rte_pktmbuf_free(mbuf);
+            }
+            else if (state_table_is_active(g_state_table, arr_idx,
+                                           pdata->arrival_ts + args->admission_cycles)) {
+                /* It would be discarded at its release anyway */
+                rte_pktmbuf_free(mbuf);
+                args->nb_early_drops++;
+            }
+            else {
+                /* Pass the packet to the delay lcore */
+                buffer_packet(mbuf, arr_idx, pdata->arrival_ts, args);
+            }
+            
+
+        } else if (ip_hdr->next_proto_id == CTL_IP_PROTO) {
+
+            int arr_idx = get_arr_idx_from_ip_packet(ip_hdr, true);
+            if (arr_idx == -1) {
+                rte_pktmbuf_free(mbuf);
+            }
+            else {
+                state_table_activate(g_state_table, arr_idx, rx_ts);
+                rte_pktmbuf_free(mbuf);
+            }
+        } else {
+            /* Other un-handled types of IP protos */
+            rte_pktmbuf_free(mbuf);
         }
-        else{
-            ip6_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv6_hdr *,
+    } 
+    else if (ether_type == RTE_ETHER_TYPE_IPV6){
+
+        /* Get the IP header */
+        ip6_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv6_hdr *,
                                          sizeof(struct rte_ether_hdr));
-            arr_idx = get_arr_idx_from_ip6_packet(ip6_hdr, false);
-        }
-        
-        /* Store the packet only if the state of the prefix is inactive */
-        if (!g_state_arr[arr_idx]) {
-
-            /* Format the packet according to the PCAP format */
-            struct rte_mbuf *pcap_mbuf = rte_pcapng_copy(port_id, 0, mbuf,
-                                                         pcap_args->pcap_mbuf_pool,
-                                                         UINT32_MAX,
-                                                         RTE_PCAPNG_DIRECTION_IN,
-                                                         NULL);
-            if (pcap_mbuf) {
-                /* Write packet to the PCAP file */
-                if (rte_pcapng_write_packets(pcap_args->pcap_hdl, &pcap_mbuf, 1) == -1) {
-                    printf("Failed to write the packet to the PCAP file\n");
-                    rte_pktmbuf_free(pcap_mbuf);
-                }
-            } else {
-                printf("Failed to allocate PCAP mbuf\n");
+
+        if (ip6_hdr->proto != CTL_IP_PROTO) {
+
+            /* Set the arrival time in the packet */
+            struct mbuf_priv_data *pdata = (struct mbuf_priv_data*) rte_mbuf_to_priv(mbuf);
+            pdata->arrival_ts = rx_clock_arrival(&args->clock, mbuf, rx_ts);
+            pdata->is_ipv6 = true;
+
+            int arr_idx = get_arr_idx_from_ip6_packet(ip6_hdr, false);
+            if (arr_idx == -1) {
+                rte_pktmbuf_free(mbuf);
+            }
+            else if (state_table_is_active(g_state_table, arr_idx,
+                                           pdata->arrival_ts + args->admission_cycles)) {
+                /* It would be discarded at its release anyway */
+                rte_pktmbuf_free(mbuf);
+                args->nb_early_drops++;
+            }
+            else {
+                /* Pass the packet to the delay lcore */
+                buffer_packet(mbuf, arr_idx, pdata->arrival_ts, args);
+            }
+
+        } else if (ip6_hdr->proto == CTL_IP_PROTO) {
+
+            int arr_idx = get_arr_idx_from_ip6_packet(ip6_hdr, true);
+            if (arr_idx == -1){
+                rte_pktmbuf_free(mbuf);
             }
-            captured_pkts++;
-            if (captured_pkts % 1000 == 0) {
-                printf("Captured %d packets\n", captured_pkts);
-                close_pcap_file(pcap_args);
-
-                const char* filename = (PCAP_FILE_NAME + std::to_string(pcap_num) + PCAP_FILE_EXT).c_str();
-                pcap_args = pcap_init(filename, port_id);
-                pcap_num++;
+            else {
+                state_table_activate(g_state_table, arr_idx, rx_ts);
+                rte_pktmbuf_free(mbuf);
             }
+        } else {
+            /* Other un-handled types of IP protos */
+            rte_pktmbuf_free(mbuf);
         }
 
-        /* Free the packet */
+    }
+    else {
+        /* Other un-handled types of ethernet types */
         rte_pktmbuf_free(mbuf);
     }
-
-    return 0;
 }
 
 /**
- * Loop to run on the first lcore.
+ * Loop to run on the RX lcores.
  *
- * This loop receives the packets from the network. It either processes the
- * packet immediately or passes the packet to the second lcore for
+ * This loop receives the packets from one RX queue. It either processes the
+ * packet immediately or passes the packet to its delay lcore for
  * further processing.
+ *
+ * The lcore serving the control queue polls it before every data burst, so
+ * that state updates do not wait behind the data traffic.
+ *
+ * The packets are stamped with their arrival time by the NIC if it can,
+ * or else with the time their burst was received.
  */
 int first_half_loop(void *_args) {
 
     int status;
 
-    struct lcore_args *args = (struct lcore_args *)_args;
+    struct rx_lcore_args *args = (struct rx_lcore_args *)_args;
 
     uint16_t port_id = args->port_id;
-    uint32_t port_ip = args->port_ip;;
-    struct rte_mempool *mbuf_pool = args->mbuf_pool;
-    struct rte_ring *mbuf_ring = args->mbuf_ring;
+    uint16_t queue_id = args->queue_id;
+    int32_t ctl_queue_id = args->ctl_queue_id;
 
     struct rte_mbuf *mbufs[BURST_SIZE];
     uint32_t nb_rx;
-    uint32_t nb_tx;
-
-    struct rte_ether_hdr *eth_hdr;
-    struct rte_arp_hdr *arp_hdr;
-    struct rte_arp_ipv4 *arp_payload;
-    struct rte_ipv4_hdr *ip_hdr;
-    struct rte_ipv6_hdr *ip6_hdr;
-    uint16_t ether_type;
+    uint64_t rx_ts;
 
     /* Get the MAC address of the given port */
     struct rte_ether_addr my_mac_addr;
@@ -561,124 +966,114 @@ int first_half_loop(void *_args) {
 
     while (1) {
 
+        /* Receive the control packets first */
+        if (ctl_queue_id >= 0) {
+            nb_rx = rte_eth_rx_burst(port_id, ctl_queue_id, mbufs, BURST_SIZE);
+            if (nb_rx > 0) {
+                rx_ts = rte_get_timer_cycles();
+                for (uint32_t i = 0; i < nb_rx; i++) {
+                    process_packet(mbufs[i], args, rx_ts);
+                }
+            }
+        }
+
         /* Receive the packets from the network */
-        nb_rx = rte_eth_rx_burst(port_id, 0, mbufs, BURST_SIZE);
-	    // printf("Num packets: %d\n", nb_rx);
-        /* Poll again if we did not receive any packets */
-        if (unlikely(nb_rx <= 0)) {
+        nb_rx = rte_eth_rx_burst(port_id, queue_id, mbufs, BURST_SIZE);
+        if (nb_rx == 0) {
             continue;
         }
 
-        /* Process each received packet */
-        for (int i = 0; i < nb_rx; i++) {
-            /* Get the type of ethernet packet */
-            eth_hdr = rte_pktmbuf_mtod(mbufs[i], struct rte_ether_hdr *);
-            ether_type = rte_be_to_cpu_16(eth_hdr->ether_type);
-            
-            // NO NEED FOR ARP, ONLY IPV4 AND IPV6 ARE SHOULD BE RECEIVED AND PROCESSED;
-            // WE DO NOT HAVE/NEED AN IP ADDR ON OUR END
-            if (ether_type == RTE_ETHER_TYPE_IPV4) {
-
-                /* Get the IP header */
-                ip_hdr = rte_pktmbuf_mtod_offset(mbufs[i], struct rte_ipv4_hdr *,
-                                                 sizeof(struct rte_ether_hdr));
-                
-                if (ip_hdr->next_proto_id != CTL_IP_PROTO) {
-                    printf("not ctl\n");
-                    /* Set the current timestamp in the packet */
-                    struct mbuf_priv_data *pdata = (struct mbuf_priv_data*) rte_mbuf_to_priv(mbufs[i]);
-                    pdata->arrival_ts = rte_get_timer_cycles();
-                    pdata->is_ipv6 = false;
-
-                    int arr_idx = get_arr_idx_from_ip_packet(ip_hdr, false);
-                    if (arr_idx == -1) {
-                        rte_pktmbuf_free(mbufs[i]);
-                    }
-                    else {
-                        printf("arr_idx: %d\n", arr_idx);
-                        if ((rte_get_timer_cycles() - g_state_last_changed_ts[arr_idx]) >
-                            (BUFFER_STATE_UPDATE_TIME * rte_get_timer_hz())) {
-                            g_state_arr[arr_idx] = 0;
-                        }
-                        /* Pass the packet to the second lcore */
-                        rte_ring_enqueue(mbuf_ring, mbufs[i]);
-                    }
-                    
-
-                } else if (ip_hdr->next_proto_id == CTL_IP_PROTO) {
-
-                    int arr_idx = get_arr_idx_from_ip_packet(ip_hdr, true);
-                    if (arr_idx == -1) {
-                        rte_pktmbuf_free(mbufs[i]);
-                    }
-                    else {
-                        printf("arr_idx: %d\n", arr_idx);
-                        g_state_arr[arr_idx] = 1;
-                        g_state_last_changed_ts[arr_idx] = rte_get_timer_cycles();
-                        rte_pktmbuf_free(mbufs[i]);
-                    }
-                } else {
-                    /* Other un-handled types of IP protos */
-                    rte_pktmbuf_free(mbufs[i]);
-                }
-            } 
-            else if (ether_type == RTE_ETHER_TYPE_IPV6){
-
-                /* Get the IP header */
-                ip6_hdr = rte_pktmbuf_mtod_offset(mbufs[i], struct rte_ipv6_hdr *,
-                                                 sizeof(struct rte_ether_hdr));
-
-                if (ip6_hdr->proto != CTL_IP_PROTO) {
-
-                    /* Set the current timestamp in the packet */
-                    struct mbuf_priv_data *pdata = (struct mbuf_priv_data*) rte_mbuf_to_priv(mbufs[i]);
-                    pdata->arrival_ts = rte_get_timer_cycles();
-                    pdata->is_ipv6 = true;
-
-                    int arr_idx = get_arr_idx_from_ip6_packet(ip6_hdr, false);
-                    if (arr_idx == -1) {
-                        rte_pktmbuf_free(mbufs[i]);
-                    }
-                    else {
-                        /* Set the state of the array to inactive only if enough seconds have passed
-                        since its last update to active*/
-                        if ((rte_get_timer_cycles() - g_state_last_changed_ts[arr_idx]) >
-                            (BUFFER_STATE_UPDATE_TIME * rte_get_timer_hz())) {
-                            g_state_arr[arr_idx] = 0;
-                        }
-                        printf("arr_idx: %d\n", arr_idx);
-                        /* Pass the packet to the second lcore */
-                        rte_ring_enqueue(mbuf_ring, mbufs[i]);
-                    }
-
-                } else if (ip6_hdr->proto == CTL_IP_PROTO) {
-
-                    int arr_idx = get_arr_idx_from_ip6_packet(ip6_hdr, true);
-                    if (arr_idx == -1){
-                        rte_pktmbuf_free(mbufs[i]);
-                    }
-                    else {
-                        printf("arr_idx: %d\n", arr_idx);
-                        g_state_arr[arr_idx] = 1;
-                        g_state_last_changed_ts[arr_idx] = rte_get_timer_cycles();
-                        rte_pktmbuf_free(mbufs[i]);
-                    }
-                } else {
-                    /* Other un-handled types of IP protos */
-                    rte_pktmbuf_free(mbufs[i]);
-                }
+        /* The timer is read once per burst */
+        rx_ts = rte_get_timer_cycles();
+        rx_clock_sync(&args->clock, rx_ts);
 
-            }
-            else {
-                /* Other un-handled types of ethernet types */
-                rte_pktmbuf_free(mbufs[i]);
-            }
+        /* Process each received packet */
+        for (uint32_t i = 0; i < nb_rx; i++) {
+            process_packet(mbufs[i], args, rx_ts);
         }
     }
 
     return 0;
 }
 
+/**
+ * Parse the optional arguments that precede the positional ones
+ */
+static int parse_options(int argc, char *argv[], struct app_options *options) {
+
+    static struct option long_options[] = {
+        {"capture-prefix", required_argument, 0, 'p'},
+        {"rotate-size", required_argument, 0, 's'},
+        {"rotate-time", required_argument, 0, 't'},
+        {"writer", no_argument, 0, 'w'},
+        {"direct-io", no_argument, 0, 'd'},
+        {"rx-lcores", required_argument, 0, 'r'},
+        {"snaplen", required_argument, 0, 'n'},
+        {"hw-timestamps", no_argument, 0, 'h'},
+        {"prefix-map", required_argument, 0, 'm'},
+        {"state-feed", required_argument, 0, 'f'},
+        {0, 0, 0, 0}
+    };
+    int opt;
+
+    options->capture_prefix = PCAP_FILE_NAME;
+    options->rotate_size_mb = CAPTURE_ROTATE_SIZE_MB;
+    options->rotate_time = 0;
+    options->writer = false;
+    options->direct_io = false;
+    options->rx_lcores = 0;
+    options->snaplen = 0;
+    options->hw_timestamps = false;
+    options->prefix_maps.clear();
+    options->state_feeds.clear();
+
+    /* The EAL parsed its own arguments with getopt too */
+    optind = 1;
+    while ((opt = getopt_long(argc, argv, "", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'p':
+                options->capture_prefix = optarg;
+                break;
+            case 's':
+                options->rotate_size_mb = strtoull(optarg, NULL, 10);
+                break;
+            case 't':
+                options->rotate_time = strtoul(optarg, NULL, 10);
+                break;
+            case 'w':
+                options->writer = true;
+                break;
+            case 'd':
+                options->direct_io = true;
+                break;
+            case 'r':
+                options->rx_lcores = strtoul(optarg, NULL, 10);
+                break;
+            case 'n':
+                options->snaplen = strtoul(optarg, NULL, 10);
+                if (options->snaplen > UINT16_MAX) {
+                    return -1;
+                }
+                break;
+            case 'h':
+                options->hw_timestamps = true;
+                break;
+            case 'm':
+                options->prefix_maps.push_back(optarg);
+                break;
+            case 'f':
+                options->state_feeds.push_back(optarg);
+                break;
+            default:
+                return -1;
+        }
+    }
+    if (options->prefix_maps.empty()) {
+        options->prefix_maps.push_back(PREFIX_MAP_FILE);
+    }
+    return optind;
+}
+
 /**
  * Entry function
  */
@@ -688,13 +1083,13 @@ int main(int argc, char *argv[]) {
     uint32_t port_ip;
     uint16_t port_id;
     struct rte_mempool *mbuf_pool;
-    struct rte_ring *mbuf_ring;
-    uint32_t first_lcore_id;
-    uint32_t second_lcore_id;
-    struct lcore_args args;
-    int pcap_fd;
-    rte_pcapng_t *pcap_hdl;
-    struct rte_mempool *pcap_mbuf_pool;
+    uint32_t nb_lcores;
+    uint32_t nb_rx_lcores;
+    uint32_t nb_delay_lcores;
+    uint16_t ctl_queue_id;
+    struct rx_clock clock;
+    uint32_t lcore_id;
+    struct app_options options;
 
     /* Initialize the DPDK environment */
     int ret = rte_eal_init(argc, argv);
@@ -706,16 +1101,35 @@ int main(int argc, char *argv[]) {
     argc -= ret;
     argv += ret;
 
-    /* Check if at least two lcores are provided */
-    if (rte_lcore_count() != 2) {
-        rte_exit(EXIT_FAILURE, "Need exactly two lcores to run this application\n");
-    }
-
     /* Parse the command line arguments */
-    if (argc < 3) {
-        rte_exit(EXIT_FAILURE, "Usage: sudo ./delayed_capture.c <DPDK EAL args...> "
+    ret = parse_options(argc, argv, &options);
+    if (ret < 0 || argc - ret < 2) {
+        rte_exit(EXIT_FAILURE, "Usage: sudo ./delayed_capture.c <DPDK EAL args...> -- "
+                 "[--capture-prefix PATH] [--rotate-size MB] [--rotate-time SECONDS] "
+                 "[--writer] [--direct-io] [--rx-lcores N] [--snaplen BYTES] [--hw-timestamps] "
+                 "[--prefix-map PATH]... [--state-feed NAME]... "
                  "<iface PCI address> <iface IP address>\n");
     }
+    argc -= ret - 1;
+    argv += ret - 1;
+
+    /**
+     * Split the lcores: the first ones (starting with the main lcore) receive
+     * packets, each from its own RX queue, and the others delay and capture
+     * them. Each delay lcore serves the rings of one or more RX lcores.
+     */
+    nb_lcores = rte_lcore_count();
+    nb_rx_lcores = options.rx_lcores ? options.rx_lcores : (nb_lcores + 1) / 2;
+    if (nb_rx_lcores >= nb_lcores) {
+        rte_exit(EXIT_FAILURE, "Need at least one lcore more than the %u RX lcores\n",
+                 nb_rx_lcores);
+    }
+    nb_delay_lcores = RTE_MIN(nb_lcores - nb_rx_lcores, nb_rx_lcores);
+    if (nb_rx_lcores + nb_delay_lcores < nb_lcores) {
+        printf("Leaving %u lcores unused, there are only %u RX lcores to serve\n",
+               nb_lcores - nb_rx_lcores - nb_delay_lcores, nb_rx_lcores);
+    }
+    printf("Using %u RX lcores and %u delay lcores\n", nb_rx_lcores, nb_delay_lcores);
 
     /* Get the port ID of the required network interface */
     port_name = argv[1];
@@ -731,8 +1145,9 @@ int main(int argc, char *argv[]) {
     printf("Port %s binded with IP %s\n", port_name, argv[2]);
 
     /* Allocate the memory for the packet buffers */
-    mbuf_pool = rte_pktmbuf_pool_create("MBUF_POOL", MBUF_POOL_SIZE,
-                                        0, sizeof(struct mbuf_priv_data),
+    mbuf_pool = rte_pktmbuf_pool_create("MBUF_POOL",
+                                        options.snaplen ? COMPACT_MBUF_POOL_SIZE : MBUF_POOL_SIZE,
+                                        MBUF_POOL_CACHE_SIZE, sizeof(struct mbuf_priv_data),
                                         RTE_MBUF_DEFAULT_BUF_SIZE,
                                         rte_socket_id());
     if (!mbuf_pool) {
@@ -740,60 +1155,152 @@ int main(int argc, char *argv[]) {
     }
     printf("Allocated the memory for packet buffers\n");
 
-    /* Allocate a ring to hold the mbufs being passed between the two lcores */
-    mbuf_ring = rte_ring_create("MBUF_RING", MBUF_RING_SIZE, rte_socket_id(),
-                                RING_F_SP_ENQ | RING_F_SC_DEQ);
-    if (!mbuf_ring) {
-        rte_exit(EXIT_FAILURE, "Cannot create mbuf ring\n");
+    /**
+     * Allocate a ring per RX lcore to hold the packets passed to its delay
+     * lcore: the mbufs themselves or, in compact mode, their first bytes
+     */
+    std::vector<struct rx_lcore_args> rx_args(nb_rx_lcores);
+    std::vector<struct delay_lcore_args> delay_args(nb_delay_lcores);
+    for (uint32_t i = 0; i < nb_rx_lcores; i++) {
+        rx_args[i].port_id = port_id;
+        rx_args[i].queue_id = i;
+        rx_args[i].ctl_queue_id = -1;
+        rx_args[i].mbuf_ring = NULL;
+        rx_args[i].slot_ring = NULL;
+        rx_args[i].admission_cycles = ADMISSION_HORIZON_TIME * rte_get_timer_hz();
+        rx_args[i].nb_early_drops = 0;
+        rx_args[i].nb_full_drops = 0;
+
+        if (options.snaplen) {
+            struct slot_ring *slot_ring = slot_ring_create(
+                COMPACT_SLOTS / rte_align32pow2(nb_rx_lcores), options.snaplen, rte_socket_id());
+            if (!slot_ring) {
+                rte_exit(EXIT_FAILURE, "Cannot create slot ring\n");
+            }
+            rx_args[i].slot_ring = slot_ring;
+            delay_args[i % nb_delay_lcores].slot_rings.push_back(slot_ring);
+            continue;
+        }
+
+        std::string ring_name = "MBUF_RING_" + std::to_string(i);
+        struct rte_ring *mbuf_ring = rte_ring_create(ring_name.c_str(), MBUF_RING_SIZE,
+                                                     rte_socket_id(),
+                                                     RING_F_SP_ENQ | RING_F_SC_DEQ);
+        if (!mbuf_ring) {
+            rte_exit(EXIT_FAILURE, "Cannot create mbuf ring\n");
+        }
+        rx_args[i].mbuf_ring = mbuf_ring;
+        delay_args[i % nb_delay_lcores].mbuf_rings.push_back(mbuf_ring);
+    }
+    if (options.snaplen) {
+        printf("Created the slot rings, keeping %u bytes per packet\n", options.snaplen);
+    }
+    else {
+        printf("Created the rings for the mbufs\n");
     }
-    printf("Created the ring for the mbufs\n");
 
-    /* Initialize the given port */
-    if (port_init(port_id, mbuf_pool)) {
+    /* Have the NIC timestamp the packets if asked to and if it can */
+    rx_clock_init(&clock, port_id);
+    if (options.hw_timestamps && rx_clock_register(&clock)) {
+        printf("Port %s cannot timestamp the packets, using the time of the bursts\n", port_name);
+    }
+
+    /* Initialize the given port, with a queue after the data queues for the control packets */
+    ctl_queue_id = nb_rx_lcores;
+    if (port_init(port_id, mbuf_pool, nb_rx_lcores + 1, nb_rx_lcores,
+                  clock.ts_offset >= 0 ? RTE_ETH_RX_OFFLOAD_TIMESTAMP : 0)) {
         rte_exit(EXIT_FAILURE, "Failed to initialize port %s\n", port_name);
     }
 
     printf("Initialized port %s\n", port_name);
 
-    /* Initialize the PCAP file */
-    const char* filename = (PCAP_FILE_NAME + std::to_string(0) + PCAP_FILE_EXT).c_str();
-    printf("Opening the packet capture file %s\n", filename);
-    struct pcap_args *first_pcap_args = pcap_init(filename, port_id);
-    printf("Initialized the packet capture structures\n");
+    if (clock.ts_offset >= 0) {
+        if (rx_clock_calibrate(&clock)) {
+            printf("Cannot read the clock of port %s, using the time of the bursts\n", port_name);
+        }
+        else {
+            printf("Using the hardware timestamps of port %s, %.3f timer cycles per tick\n",
+                   port_name, clock.cycles_per_tick);
+        }
+    }
+    for (uint32_t i = 0; i < nb_rx_lcores; i++) {
+        rx_args[i].clock = clock;
+    }
 
-    /* Get the lcore IDs */
-    first_lcore_id = rte_get_next_lcore(LCORE_ID_ANY, 0, 1);
-    second_lcore_id = rte_get_next_lcore(first_lcore_id, 0, 1);
+    /**
+     * Steer the control packets to their queue, served by the main lcore.
+     * Without the flow rules they arrive on the data queues, and are handled
+     * there as well, only later.
+     */
+    rx_args[0].ctl_queue_id = ctl_queue_id;
+    if (steer_ctl_packets(port_id, ctl_queue_id, false) &&
+        steer_ctl_packets(port_id, ctl_queue_id, true)) {
+        printf("Steering the control packets to RX queue %u\n", ctl_queue_id);
+    }
 
-    /* Initialize the arguments to the lcore functions */
-    args.port_id = port_id;
-    args.port_ip = port_ip;
-    args.mbuf_pool = mbuf_pool;
-    args.mbuf_ring = mbuf_ring;
-    args.pcap_args = first_pcap_args;
+    /* Initialize the packet capture output of each delay lcore */
+    for (uint32_t i = 0; i < nb_delay_lcores; i++) {
+        std::string prefix = options.capture_prefix;
+        if (nb_delay_lcores > 1) {
+            prefix += std::to_string(i) + ".";
+        }
+        delay_args[i].capture = capture_output_create(prefix, i,
+                                                      options.rotate_size_mb << 20,
+                                                      options.rotate_time,
+                                                      options.writer,
+                                                      options.direct_io,
+                                                      rte_socket_id());
+        printf("Initialized the packet capture output %s0%s\n",
+               prefix.c_str(), PCAP_FILE_EXT);
+    }
 
     /* Read the mapping of IP addresses to indices */
-    read_mapping("prefixes.txt");
-
-    /* Launch the work on the second lcore */
-    if (rte_eal_remote_launch(second_half_loop, &args, second_lcore_id)) {
-        rte_exit(EXIT_FAILURE, "Failed to launch work on lcore %d\n",
-                 second_lcore_id);
+    read_mapping(options.prefix_maps, options.state_feeds);
+
+    /* Launch the work on the lcores; the main lcore is the first RX lcore */
+    uint32_t lcore_idx = 0;
+    RTE_LCORE_FOREACH_WORKER(lcore_id) {
+        lcore_idx++;
+        if (lcore_idx < nb_rx_lcores) {
+            ret = rte_eal_remote_launch(first_half_loop, &rx_args[lcore_idx], lcore_id);
+            printf("Launched RX queue %u on lcore %u\n", lcore_idx, lcore_id);
+        }
+        else if (lcore_idx < nb_rx_lcores + nb_delay_lcores) {
+            ret = rte_eal_remote_launch(second_half_loop, &delay_args[lcore_idx - nb_rx_lcores],
+                                        lcore_id);
+            printf("Launched delay lcore %u on lcore %u\n", lcore_idx - nb_rx_lcores, lcore_id);
+        }
+        else {
+            continue;
+        }
+        if (ret) {
+            rte_exit(EXIT_FAILURE, "Failed to launch work on lcore %d\n", lcore_id);
+        }
     }
-    printf("Launched the second half of the loop on lcore %d\n",
-           second_lcore_id);
 
-    /* Launch the work on the first (main) lcore */
-    printf("Launching the first half of the loop on lcore %d\n",
-           first_lcore_id);
-    first_half_loop(&args);
+    /* Launch the work on the main lcore */
+    printf("Launching RX queue 0 on lcore %d\n", rte_lcore_id());
+    first_half_loop(&rx_args[0]);
 
     /* Wait for the lcores */
-    rte_eal_wait_lcore(second_lcore_id);
+    rte_eal_mp_wait_lcore();
 
-    /* Close pcap file */
-    close_pcap_file(first_pcap_args);
-    delete first_pcap_args;
+    for (uint32_t i = 0; i < nb_rx_lcores; i++) {
+        printf("RX queue %u: dropped %" PRIu64 " packets to active prefixes on arrival, "
+               "%" PRIu64 " packets as the ring was full\n",
+               i, rx_args[i].nb_early_drops, rx_args[i].nb_full_drops);
+    }
+
+    prefix_table_free(ip_table);
+    state_table_free(g_state_table);
+    for (struct state_feed &feed : g_state_feeds) {
+        state_feed_close(&feed);
+    }
+
+    /* Write the remaining packets and close the capture files */
+    for (uint32_t i = 0; i < nb_delay_lcores; i++) {
+        capture_output_close(delay_args[i].capture);
+    }
 
     /* Deinitialize the port */
     if (port_deinit(port_id)) {
@@ -801,9 +1308,16 @@ int main(int argc, char *argv[]) {
     }
     printf("De-initialized port %s\n", port_name);
 
-    /* Deinitialize the mbuf ring */
-    rte_ring_free(mbuf_ring);
-    printf("Destroyed the ring for mbufs\n");
+    /* Deinitialize the mbuf rings */
+    for (uint32_t i = 0; i < nb_rx_lcores; i++) {
+        if (rx_args[i].slot_ring) {
+            slot_ring_free(rx_args[i].slot_ring);
+        }
+        else {
+            rte_ring_free(rx_args[i].mbuf_ring);
+        }
+    }
+    printf("Destroyed the rings for mbufs\n");
 
     /* Deinitialize the mbuf pool */
     rte_mempool_free(mbuf_pool);
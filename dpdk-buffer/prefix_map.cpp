@@ -0,0 +1,91 @@
+#include "prefix_map.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * Check that a record describes a prefix the lookups can handle: IPv6
+ * indices are computed from the upper 64 bits of the address
+ */
+static bool prefix_map_record_is_valid(const struct prefix_map_record *record) {
+
+    uint32_t max_unit_len;
+
+    if (record->family == 4) {
+        max_unit_len = 32;
+    }
+    else if (record->family == 6) {
+        max_unit_len = 64;
+    }
+    else {
+        return false;
+    }
+    return record->prefix_len <= record->unit_len && record->unit_len <= max_unit_len &&
+           record->unit_len - record->prefix_len < 31;
+}
+
+int prefix_map_open(struct prefix_map *map, const char *path) {
+
+    struct stat st;
+    const struct prefix_map_header *header;
+
+    memset(map, 0, sizeof(struct prefix_map));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("Cannot open the prefix map %s\n", path);
+        return -1;
+    }
+    if (fstat(fd, &st) || (size_t)st.st_size < sizeof(struct prefix_map_header)) {
+        printf("The prefix map %s is truncated\n", path);
+        close(fd);
+        return -1;
+    }
+
+    map->size = st.st_size;
+    map->data = mmap(NULL, map->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map->data == MAP_FAILED) {
+        printf("Cannot map the prefix map %s\n", path);
+        map->data = NULL;
+        return -1;
+    }
+
+    header = (const struct prefix_map_header *)map->data;
+    if (memcmp(header->magic, PREFIX_MAP_MAGIC, sizeof(header->magic)) ||
+        header->version != PREFIX_MAP_VERSION ||
+        header->record_size != sizeof(struct prefix_map_record)) {
+        printf("%s is not a version %u prefix map\n", path, PREFIX_MAP_VERSION);
+        prefix_map_close(map);
+        return -1;
+    }
+    if (map->size < sizeof(struct prefix_map_header) +
+                    (size_t)header->nb_records * sizeof(struct prefix_map_record)) {
+        printf("The prefix map %s is truncated\n", path);
+        prefix_map_close(map);
+        return -1;
+    }
+
+    map->records = (const struct prefix_map_record *)(header + 1);
+    map->nb_records = header->nb_records;
+    for (uint32_t i = 0; i < map->nb_records; i++) {
+        if (!prefix_map_record_is_valid(&map->records[i])) {
+            printf("Record %u of the prefix map %s is invalid\n", i, path);
+            prefix_map_close(map);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+void prefix_map_close(struct prefix_map *map) {
+    if (map->data) {
+        munmap(map->data, map->size);
+    }
+    memset(map, 0, sizeof(struct prefix_map));
+}
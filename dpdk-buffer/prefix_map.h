@@ -0,0 +1,59 @@
+#ifndef PREFIX_MAP_H
+#define PREFIX_MAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Binary map of the monitored prefixes, written by the controller
+ *
+ * A header followed by one record per monitored prefix. Each prefix is
+ * split into blocks of 2^(addr bits - unit_len) addresses, single IPv4
+ * addresses and IPv6 /56s as the data plane tracks them, and its blocks
+ * get consecutive indices from base_idx on. The index of an address is
+ * computed from its record, so the file stays a few bytes per prefix.
+ *
+ * The layout is shared with PrefixMap.h of the controllers.
+ */
+
+#define PREFIX_MAP_MAGIC         "TPFX"
+#define PREFIX_MAP_VERSION       (1u)
+
+struct __attribute__((packed)) prefix_map_header {
+    char magic[4];
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t nb_records;
+};
+
+struct __attribute__((packed)) prefix_map_record {
+    uint8_t addr[16];            /* network byte order, IPv4 in the first 4 bytes */
+    uint32_t base_idx;
+    uint8_t family;              /* 4 or 6 */
+    uint8_t prefix_len;
+    uint8_t unit_len;            /* each index covers a /unit_len */
+    uint8_t reserved;
+};
+
+/* A map file mapped into memory */
+struct prefix_map {
+    void *data;
+    size_t size;
+    const struct prefix_map_record *records;
+    uint32_t nb_records;
+};
+
+/**
+ * Map the file at path and check its header and records. Returns 0 on
+ * success, or -1 with an error printed.
+ */
+int prefix_map_open(struct prefix_map *map, const char *path);
+
+void prefix_map_close(struct prefix_map *map);
+
+/* Number of indices of a record */
+static inline uint64_t prefix_map_record_indices(const struct prefix_map_record *record) {
+    return 1ull << (record->unit_len - record->prefix_len);
+}
+
+#endif /* PREFIX_MAP_H */
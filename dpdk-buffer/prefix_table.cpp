@@ -0,0 +1,99 @@
+#include "prefix_table.h"
+
+#include <string.h>
+#include <algorithm>
+#include <unordered_map>
+
+#include <rte_common.h>
+#include <rte_malloc.h>
+
+struct prefix_table *prefix_table_create(const std::vector<struct prefix_range> &ranges,
+                                         uint32_t shift, int socket_id) {
+
+    struct prefix_table *table = new struct prefix_table;
+    memset(table, 0, sizeof(struct prefix_table));
+    table->shift = shift;
+
+    table->tbl24 = (uint32_t *)rte_zmalloc_socket("PREFIX_TBL24",
+                                                  PREFIX_TBL24_SIZE * sizeof(uint32_t),
+                                                  RTE_CACHE_LINE_SIZE, socket_id);
+    if (!table->tbl24 || shift > 8) {
+        prefix_table_free(table);
+        return NULL;
+    }
+
+    /* Longer prefixes are filled in last, so that they win */
+    std::vector<struct prefix_range> sorted(ranges);
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const struct prefix_range &a, const struct prefix_range &b) {
+                         return a.len < b.len;
+                     });
+
+    /* Every /24 holding a prefix longer than /24 gets a group */
+    std::unordered_map<uint32_t, uint32_t> groups;
+    for (struct prefix_range &range : sorted) {
+        if (range.len > 32) {
+            prefix_table_free(table);
+            return NULL;
+        }
+        range.addr &= range.len ? ~0u << (32 - range.len) : 0;
+        uint64_t last_idx = range.base_idx + (((1ull << (32 - range.len)) - 1) >> shift);
+        if (last_idx > PREFIX_ENTRY_VALUE_MASK) {
+            prefix_table_free(table);
+            return NULL;
+        }
+        if (range.len > 24) {
+            groups.emplace(range.addr >> 8, groups.size());
+        }
+    }
+
+    table->nb_tbl8_groups = groups.size();
+    if (table->nb_tbl8_groups) {
+        size_t tbl8_size = table->nb_tbl8_groups * PREFIX_TBL8_GROUP_SIZE * sizeof(uint32_t);
+        table->tbl8 = (uint32_t *)rte_zmalloc_socket("PREFIX_TBL8", tbl8_size,
+                                                     RTE_CACHE_LINE_SIZE, socket_id);
+        if (!table->tbl8) {
+            prefix_table_free(table);
+            return NULL;
+        }
+    }
+    for (auto &group : groups) {
+        table->tbl24[group.first] = PREFIX_ENTRY_VALID | PREFIX_ENTRY_TBL8 | group.second;
+    }
+
+    for (const struct prefix_range &range : sorted) {
+        if (range.len <= 24) {
+            for (uint64_t i = 0; i < (1ull << (24 - range.len)); i++) {
+                uint32_t tbl24_idx = (range.addr >> 8) + i;
+                uint32_t base_idx = range.base_idx + ((i << 8) >> shift);
+                uint32_t entry = table->tbl24[tbl24_idx];
+                if (entry & PREFIX_ENTRY_TBL8) {
+                    /* A longer prefix shares this /24 */
+                    uint32_t *group = &table->tbl8[(entry & PREFIX_ENTRY_VALUE_MASK) * PREFIX_TBL8_GROUP_SIZE];
+                    for (uint32_t j = 0; j < PREFIX_TBL8_GROUP_SIZE; j++) {
+                        group[j] = PREFIX_ENTRY_VALID | (base_idx + (j >> shift));
+                    }
+                }
+                else {
+                    table->nb_direct += !entry;
+                    table->tbl24[tbl24_idx] = PREFIX_ENTRY_VALID | base_idx;
+                }
+            }
+        }
+        else {
+            uint32_t entry = table->tbl24[range.addr >> 8];
+            uint32_t *group = &table->tbl8[(entry & PREFIX_ENTRY_VALUE_MASK) * PREFIX_TBL8_GROUP_SIZE];
+            for (uint32_t j = 0; j < (1u << (32 - range.len)); j++) {
+                group[(range.addr & 0xFF) + j] = PREFIX_ENTRY_VALID | (range.base_idx + (j >> shift));
+            }
+        }
+    }
+
+    return table;
+}
+
+void prefix_table_free(struct prefix_table *table) {
+    rte_free(table->tbl24);
+    rte_free(table->tbl8);
+    delete table;
+}
@@ -0,0 +1,77 @@
+#ifndef PREFIX_TABLE_H
+#define PREFIX_TABLE_H
+
+#include <stdint.h>
+#include <vector>
+
+#include <rte_branch_prediction.h>
+
+/**
+ * DIR-24-8 table mapping monitored IPv4 addresses to their array index
+ *
+ * The monitored prefixes are split into blocks of 2^shift addresses, and
+ * the blocks of a prefix have consecutive indices. tbl24 has one entry per
+ * /24. When a /24 lies within a single prefix (the usual case), the entry
+ * holds the index of its first block and the index of any address in the
+ * /24 is computed from its last byte. Otherwise the entry points to a group
+ * of 256 tbl8 entries holding one index per address.
+ *
+ * A lookup is therefore one or two array reads, with no hashing.
+ */
+
+#define PREFIX_TBL24_SIZE        (1u << 24)
+#define PREFIX_TBL8_GROUP_SIZE   (256u)
+
+/* Entry layout: valid bit, tbl8 bit (tbl24 only) and a 30-bit value */
+#define PREFIX_ENTRY_VALID       (1u << 31)
+#define PREFIX_ENTRY_TBL8        (1u << 30)
+#define PREFIX_ENTRY_VALUE_MASK  (PREFIX_ENTRY_TBL8 - 1)
+
+struct prefix_table {
+    uint32_t *tbl24;
+    uint32_t *tbl8;
+    uint32_t shift;              /* log2 of the addresses per index, at most 8 */
+    uint32_t nb_tbl8_groups;
+    uint32_t nb_direct;          /* /24s resolved by tbl24 alone */
+};
+
+/* A monitored prefix and the index of its first block */
+struct prefix_range {
+    uint32_t addr;               /* host byte order */
+    uint32_t len;
+    uint32_t base_idx;
+};
+
+/**
+ * Build the table from the monitored prefixes; an address gets the index
+ * base_idx + ((addr - prefix) >> shift). Where prefixes overlap, the
+ * longest one wins, as in the data plane. Returns NULL if the memory
+ * cannot be allocated or an index does not fit.
+ */
+struct prefix_table *prefix_table_create(const std::vector<struct prefix_range> &ranges,
+                                         uint32_t shift, int socket_id);
+
+void prefix_table_free(struct prefix_table *table);
+
+/**
+ * Get the index of an address (host byte order), or -1 if it is not monitored
+ */
+static inline int prefix_table_lookup(const struct prefix_table *table, uint32_t addr) {
+
+    uint32_t entry = table->tbl24[addr >> 8];
+
+    if (likely(!(entry & PREFIX_ENTRY_TBL8))) {
+        if (!entry) {
+            return -1;
+        }
+        return (entry & PREFIX_ENTRY_VALUE_MASK) + ((addr & 0xFF) >> table->shift);
+    }
+
+    entry = table->tbl8[(entry & PREFIX_ENTRY_VALUE_MASK) * PREFIX_TBL8_GROUP_SIZE + (addr & 0xFF)];
+    if (!entry) {
+        return -1;
+    }
+    return entry & PREFIX_ENTRY_VALUE_MASK;
+}
+
+#endif /* PREFIX_TABLE_H */
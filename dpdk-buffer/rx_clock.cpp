@@ -0,0 +1,55 @@
+#include "rx_clock.h"
+
+void rx_clock_init(struct rx_clock *clock, uint16_t port_id) {
+    clock->port_id = port_id;
+    clock->ts_offset = -1;
+    clock->ts_flag = 0;
+    clock->cycles_per_tick = 0;
+    clock->sync_cycles = RX_CLOCK_SYNC_MS * rte_get_timer_hz() / 1000;
+    clock->anchor_tick = 0;
+    clock->anchor_cycles = 0;
+}
+
+int rx_clock_register(struct rx_clock *clock) {
+
+    struct rte_eth_dev_info dev_info;
+    int status;
+
+    status = rte_eth_dev_info_get(clock->port_id, &dev_info);
+    if (status) {
+        return status;
+    }
+    if (!(dev_info.rx_offload_capa & RTE_ETH_RX_OFFLOAD_TIMESTAMP)) {
+        return -1;
+    }
+
+    return rte_mbuf_dyn_rx_timestamp_register(&clock->ts_offset, &clock->ts_flag);
+}
+
+int rx_clock_calibrate(struct rx_clock *clock) {
+
+    uint64_t start_tick, end_tick;
+    uint64_t start_cycles, end_cycles;
+
+    if (clock->ts_offset < 0) {
+        return -1;
+    }
+
+    if (rte_eth_read_clock(clock->port_id, &start_tick)) {
+        clock->ts_offset = -1;
+        return -1;
+    }
+    start_cycles = rte_get_timer_cycles();
+    rte_delay_ms(RX_CLOCK_CALIBRATE_MS);
+    if (rte_eth_read_clock(clock->port_id, &end_tick) || end_tick == start_tick) {
+        clock->ts_offset = -1;
+        return -1;
+    }
+    end_cycles = rte_get_timer_cycles();
+
+    clock->cycles_per_tick = (double)(end_cycles - start_cycles) / (end_tick - start_tick);
+    clock->anchor_tick = end_tick;
+    clock->anchor_cycles = end_cycles;
+
+    return 0;
+}
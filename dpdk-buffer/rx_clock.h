@@ -0,0 +1,94 @@
+#ifndef RX_CLOCK_H
+#define RX_CLOCK_H
+
+#include <stdint.h>
+
+#include <rte_branch_prediction.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_ethdev.h>
+#include <rte_mbuf.h>
+#include <rte_mbuf_dyn.h>
+
+/**
+ * Arrival time of the received packets, in timer cycles
+ *
+ * With hardware timestamps, the NIC stamps each packet as it arrives, in
+ * ticks of its own clock, into a dynamic mbuf field. A stamp is converted
+ * to timer cycles from an anchor, a reading of the NIC clock taken along
+ * with the timer, using the rate of the NIC clock measured at startup.
+ * Each RX lcore moves its anchor forward every RX_CLOCK_SYNC_MS, so that
+ * the drift between the two clocks does not add up.
+ *
+ * Without hardware timestamps, and for the packets the NIC did not stamp,
+ * the arrival time is the time their burst was received, read once per
+ * burst.
+ */
+
+/* Time between two anchors (in milliseconds) */
+#define RX_CLOCK_SYNC_MS         (100u)
+
+/* Time over which the rate of the NIC clock is measured (in milliseconds) */
+#define RX_CLOCK_CALIBRATE_MS    (100u)
+
+struct rx_clock {
+    uint16_t port_id;
+    int ts_offset;               /* of the timestamp field, -1 without hardware timestamps */
+    uint64_t ts_flag;
+    double cycles_per_tick;
+    uint64_t sync_cycles;        /* RX_CLOCK_SYNC_MS in timer cycles */
+    uint64_t anchor_tick;
+    uint64_t anchor_cycles;
+};
+
+/* Use the time of the bursts only */
+void rx_clock_init(struct rx_clock *clock, uint16_t port_id);
+
+/**
+ * Register the timestamp field, before the port is configured with
+ * RTE_ETH_RX_OFFLOAD_TIMESTAMP. Returns 0 on success, or nonzero if the
+ * port cannot timestamp the packets.
+ */
+int rx_clock_register(struct rx_clock *clock);
+
+/**
+ * Measure the rate of the NIC clock, once the port is started. Returns 0
+ * on success, or nonzero if the NIC clock cannot be read; the burst times
+ * are used then.
+ */
+int rx_clock_calibrate(struct rx_clock *clock);
+
+/**
+ * Move the anchor forward if it is older than RX_CLOCK_SYNC_MS; rx_ts is
+ * the time of the current burst
+ */
+static inline void rx_clock_sync(struct rx_clock *clock, uint64_t rx_ts) {
+
+    uint64_t tick;
+
+    if (likely(clock->ts_offset < 0 || rx_ts - clock->anchor_cycles < clock->sync_cycles)) {
+        return;
+    }
+    if (rte_eth_read_clock(clock->port_id, &tick) == 0) {
+        clock->anchor_cycles = rte_get_timer_cycles();
+        clock->anchor_tick = tick;
+    }
+}
+
+/* Arrival time of a packet of the burst received at rx_ts */
+static inline uint64_t rx_clock_arrival(const struct rx_clock *clock, const struct rte_mbuf *mbuf,
+                                        uint64_t rx_ts) {
+
+    if (clock->ts_offset < 0 || !(mbuf->ol_flags & clock->ts_flag)) {
+        return rx_ts;
+    }
+
+    rte_mbuf_timestamp_t tick = *RTE_MBUF_DYNFIELD(mbuf, clock->ts_offset, rte_mbuf_timestamp_t *);
+    int64_t ticks = (int64_t)(tick - clock->anchor_tick);
+    uint64_t arrival_ts = clock->anchor_cycles + (int64_t)(ticks * clock->cycles_per_tick);
+
+    /* A conversion error must not put the arrival after the reception */
+    return RTE_MIN(arrival_ts, rx_ts);
+}
+
+#endif /* RX_CLOCK_H */
@@ -0,0 +1,28 @@
+#include "slot_ring.h"
+
+#include <rte_malloc.h>
+
+struct slot_ring *slot_ring_create(uint32_t nb_slots, uint32_t snaplen, int socket_id) {
+
+    struct slot_ring *ring = new struct slot_ring;
+
+    ring->snaplen = snaplen;
+    ring->slot_size = RTE_ALIGN_CEIL(sizeof(struct packet_slot) + snaplen, RTE_CACHE_LINE_SIZE);
+    ring->mask = nb_slots - 1;
+    ring->head = 0;
+    ring->tail = 0;
+
+    ring->slots = (uint8_t *)rte_malloc_socket("SLOT_RING", (size_t)nb_slots * ring->slot_size,
+                                               RTE_CACHE_LINE_SIZE, socket_id);
+    if (!ring->slots) {
+        delete ring;
+        return NULL;
+    }
+
+    return ring;
+}
+
+void slot_ring_free(struct slot_ring *ring) {
+    rte_free(ring->slots);
+    delete ring;
+}
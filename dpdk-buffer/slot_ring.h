@@ -0,0 +1,99 @@
+#ifndef SLOT_RING_H
+#define SLOT_RING_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+#include <rte_branch_prediction.h>
+#include <rte_common.h>
+#include <rte_mbuf.h>
+
+/**
+ * Compact delay buffer between an RX lcore and its delay lcore
+ *
+ * Instead of holding on to the mbuf of a buffered packet, the RX lcore
+ * copies its first bytes (up to the snap length) and its metadata into
+ * the next slot of a large contiguous ring, and frees the mbuf at once.
+ * Slots have a fixed size, so a slot takes a cache line or two where an
+ * mbuf takes over 2 KB. The ring has a single producer and a single
+ * consumer, and is in arrival order like the mbuf rings.
+ */
+
+/* A buffered packet */
+struct packet_slot {
+    uint64_t arrival_ts;
+    uint32_t arr_idx;
+    uint16_t pkt_len;            /* of the packet on the wire */
+    uint16_t cap_len;            /* bytes kept in data */
+    uint8_t data[];
+};
+
+struct slot_ring {
+    uint8_t *slots;
+    uint32_t slot_size;
+    uint32_t snaplen;
+    uint32_t mask;               /* number of slots - 1 */
+
+    /* Written by the producer and the consumer respectively */
+    alignas(RTE_CACHE_LINE_SIZE) std::atomic<uint32_t> head;
+    alignas(RTE_CACHE_LINE_SIZE) std::atomic<uint32_t> tail;
+};
+
+/**
+ * Create a ring of nb_slots (a power of 2) slots keeping the first snaplen
+ * bytes of each packet. Returns NULL if the memory cannot be allocated.
+ */
+struct slot_ring *slot_ring_create(uint32_t nb_slots, uint32_t snaplen, int socket_id);
+
+void slot_ring_free(struct slot_ring *ring);
+
+static inline struct packet_slot *slot_ring_at(const struct slot_ring *ring, uint32_t pos) {
+    return (struct packet_slot *)(ring->slots + (size_t)(pos & ring->mask) * ring->slot_size);
+}
+
+/**
+ * Copy a packet into the next slot. Returns false if the ring is full;
+ * the caller keeps ownership of mbuf either way.
+ */
+static inline bool slot_ring_push(struct slot_ring *ring, struct rte_mbuf *mbuf,
+                                  uint64_t arrival_ts, uint32_t arr_idx) {
+
+    uint32_t head = ring->head.load(std::memory_order_relaxed);
+    if (unlikely(head - ring->tail.load(std::memory_order_acquire) > ring->mask)) {
+        return false;
+    }
+
+    struct packet_slot *slot = slot_ring_at(ring, head);
+    uint32_t pkt_len = rte_pktmbuf_pkt_len(mbuf);
+    uint32_t cap_len = RTE_MIN(pkt_len, ring->snaplen);
+
+    slot->arrival_ts = arrival_ts;
+    slot->arr_idx = arr_idx;
+    slot->pkt_len = RTE_MIN(pkt_len, (uint32_t)UINT16_MAX);
+    slot->cap_len = cap_len;
+    const void *data = rte_pktmbuf_read(mbuf, 0, cap_len, slot->data);
+    if (data != slot->data) {
+        memcpy(slot->data, data, cap_len);
+    }
+
+    ring->head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+/* Number of packets the consumer can read */
+static inline uint32_t slot_ring_count(const struct slot_ring *ring) {
+    return ring->head.load(std::memory_order_acquire) - ring->tail.load(std::memory_order_relaxed);
+}
+
+/* The packet i places after the oldest one; i must be below slot_ring_count() */
+static inline struct packet_slot *slot_ring_peek(const struct slot_ring *ring, uint32_t i) {
+    return slot_ring_at(ring, ring->tail.load(std::memory_order_relaxed) + i);
+}
+
+/* Give the n oldest slots back to the producer */
+static inline void slot_ring_pop(struct slot_ring *ring, uint32_t n) {
+    ring->tail.store(ring->tail.load(std::memory_order_relaxed) + n, std::memory_order_release);
+}
+
+#endif /* SLOT_RING_H */
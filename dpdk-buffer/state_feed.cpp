@@ -0,0 +1,73 @@
+#include "state_feed.h"
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+int state_feed_open(struct state_feed *feed, const char *name, uint32_t base_idx,
+                    uint32_t nb_bits) {
+
+    struct stat st;
+    std::string shm_name = std::string("/") + name;
+
+    memset(feed, 0, sizeof(struct state_feed));
+
+    int fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        printf("Cannot open the state feed %s; is its controller running?\n", name);
+        return -1;
+    }
+    if (fstat(fd, &st) || (size_t)st.st_size < sizeof(struct state_feed_header)) {
+        printf("The state feed %s is truncated\n", name);
+        close(fd);
+        return -1;
+    }
+
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        printf("Cannot map the state feed %s\n", name);
+        return -1;
+    }
+    feed->header = (const struct state_feed_header *)data;
+    feed->size = st.st_size;
+
+    const struct state_feed_header *header = feed->header;
+    if (memcmp(header->magic, STATE_FEED_MAGIC, sizeof(header->magic)) ||
+        header->version != STATE_FEED_VERSION || header->data_offset % sizeof(uint64_t)) {
+        printf("%s is not a version %u state feed\n", name, STATE_FEED_VERSION);
+        state_feed_close(feed);
+        return -1;
+    }
+    if (header->nb_bits != nb_bits) {
+        printf("The state feed %s has %" PRIu64 " addresses, its prefix map %u\n",
+               name, header->nb_bits, nb_bits);
+        state_feed_close(feed);
+        return -1;
+    }
+
+    feed->nb_words = (nb_bits + 63) / 64;
+    if (feed->size < header->data_offset + 2 * feed->nb_words * sizeof(uint64_t)) {
+        printf("The state feed %s is truncated\n", name);
+        state_feed_close(feed);
+        return -1;
+    }
+    feed->bitmaps = (const uint64_t *)((const uint8_t *)data + header->data_offset);
+    feed->base_idx = base_idx;
+    feed->nb_bits = nb_bits;
+
+    return 0;
+}
+
+void state_feed_close(struct state_feed *feed) {
+    if (feed->header) {
+        munmap((void *)feed->header, feed->size);
+    }
+    memset(feed, 0, sizeof(struct state_feed));
+}
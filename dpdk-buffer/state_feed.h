@@ -0,0 +1,68 @@
+#ifndef STATE_FEED_H
+#define STATE_FEED_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * Activity state published by a controller through shared memory
+ *
+ * After each epoch the controller writes a bitmap with one bit per
+ * address index of its prefix map, set while the address is active, into
+ * the older of two copies, then bumps the sequence number; copy seq & 1 is
+ * the latest. A reader that loads seq and reads the copy right away sees a
+ * whole epoch, since that copy is rewritten only an epoch later. The
+ * object is mapped read-only.
+ *
+ * The layout is shared with ActivityFeed.h of the controllers.
+ */
+
+#define STATE_FEED_MAGIC         "TACT"
+#define STATE_FEED_VERSION       (1u)
+
+struct state_feed_header {
+    char magic[4];
+    uint16_t version;
+    uint16_t data_offset;        /* of the first bitmap */
+    uint32_t interval_ms;        /* time between two epochs */
+    uint32_t reserved;
+    uint64_t nb_bits;            /* address indices per bitmap */
+    std::atomic<uint64_t> seq;   /* epochs published */
+};
+
+struct state_feed {
+    const struct state_feed_header *header;
+    const uint64_t *bitmaps;
+    size_t size;
+    uint64_t nb_words;           /* per bitmap */
+    uint32_t base_idx;           /* index of its first address in the state table */
+    uint32_t nb_bits;
+};
+
+/**
+ * Map the feed published as name by the controller of the prefix map
+ * whose indices start at base_idx and check that it has nb_bits addresses.
+ * Returns 0 on success, or -1 with an error printed.
+ */
+int state_feed_open(struct state_feed *feed, const char *name, uint32_t base_idx,
+                    uint32_t nb_bits);
+
+void state_feed_close(struct state_feed *feed);
+
+/* Check if the address at idx (of the state table) belongs to the feed */
+static inline bool state_feed_covers(const struct state_feed *feed, uint32_t idx) {
+    return idx - feed->base_idx < feed->nb_bits;
+}
+
+/**
+ * Check if the address at idx (of the state table, covered by the feed)
+ * was active in the last epoch published
+ */
+static inline bool state_feed_is_active(const struct state_feed *feed, uint32_t idx) {
+    uint64_t seq = feed->header->seq.load(std::memory_order_acquire);
+    uint32_t bit = idx - feed->base_idx;
+    return (feed->bitmaps[(seq & 1) * feed->nb_words + (bit >> 6)] >> (bit & 63)) & 1;
+}
+
+#endif /* STATE_FEED_H */
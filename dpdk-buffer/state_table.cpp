@@ -0,0 +1,27 @@
+#include "state_table.h"
+
+#include <rte_common.h>
+#include <rte_malloc.h>
+
+struct state_table *state_table_create(uint32_t size, uint64_t expiry_cycles, int socket_id) {
+
+    struct state_table *table = new struct state_table;
+
+    /* A zeroed record is an inactive prefix */
+    table->records = (std::atomic<uint64_t> *)rte_zmalloc_socket("STATE_TABLE",
+                                                                 RTE_MAX(size, 1u) * sizeof(uint64_t),
+                                                                 RTE_CACHE_LINE_SIZE, socket_id);
+    if (!table->records) {
+        delete table;
+        return NULL;
+    }
+    table->size = size;
+    table->expiry_cycles = expiry_cycles;
+
+    return table;
+}
+
+void state_table_free(struct state_table *table) {
+    rte_free(table->records);
+    delete table;
+}
@@ -0,0 +1,72 @@
+#ifndef STATE_TABLE_H
+#define STATE_TABLE_H
+
+#include <stdint.h>
+#include <atomic>
+
+#include <rte_prefetch.h>
+
+/**
+ * Activity state of the monitored prefixes, shared by the lcores
+ *
+ * Each prefix has an 8-byte record holding its active bit and the time (in
+ * timer cycles) it was last reported active. Records are always written
+ * whole with relaxed atomic stores, so a reader sees either the old or the
+ * new record and no lcore does a read-modify-write. A prefix turns inactive
+ * by itself once it has not been reported active for the expiry time, so
+ * only the control packets write to the table.
+ */
+
+#define STATE_ACTIVE             (1ull << 63)
+#define STATE_TS_MASK            (STATE_ACTIVE - 1)
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+              "state records must be plain 64-bit words");
+
+struct state_table {
+    std::atomic<uint64_t> *records;  /* cache-line aligned */
+    uint32_t size;
+    int64_t expiry_cycles;
+};
+
+/**
+ * Create a table of size inactive prefixes, which stay active for
+ * expiry_cycles after being reported. Returns NULL if the memory cannot
+ * be allocated.
+ */
+struct state_table *state_table_create(uint32_t size, uint64_t expiry_cycles, int socket_id);
+
+void state_table_free(struct state_table *table);
+
+/* Report the prefix at idx active at time ts */
+static inline void state_table_activate(struct state_table *table, uint32_t idx, uint64_t ts) {
+    table->records[idx].store(STATE_ACTIVE | (ts & STATE_TS_MASK), std::memory_order_relaxed);
+}
+
+/**
+ * Check if the prefix at idx is active at time ts. The activation may be
+ * more recent than ts when another lcore reported it meanwhile.
+ */
+static inline bool state_table_is_active(const struct state_table *table, uint32_t idx,
+                                         uint64_t ts) {
+    uint64_t record = table->records[idx].load(std::memory_order_relaxed);
+    int64_t age = (int64_t)((ts & STATE_TS_MASK) - (record & STATE_TS_MASK));
+    return (record & STATE_ACTIVE) && age <= table->expiry_cycles;
+}
+
+/**
+ * Check the state of a burst of prefixes at time ts: active[i] tells
+ * whether the prefix at indices[i] is active. The records are prefetched
+ * first, so that their cache misses overlap.
+ */
+static inline void state_table_query_bulk(const struct state_table *table, const uint32_t *indices,
+                                          uint32_t nb_indices, uint64_t ts, bool *active) {
+    for (uint32_t i = 0; i < nb_indices; i++) {
+        rte_prefetch0(&table->records[indices[i]]);
+    }
+    for (uint32_t i = 0; i < nb_indices; i++) {
+        active[i] = state_table_is_active(table, indices[i], ts);
+    }
+}
+
+#endif /* STATE_TABLE_H */
@@ -1,40 +0,0 @@
-#ifndef METER_H // Include guards to prevent multiple inclusion
-
-#define METER_H
-
-#include <bf_rt/bf_rt.hpp>
-#include <bf_rt/bf_rt_info.hpp>
-#include <bf_rt/bf_rt_init.hpp>
-#include <bf_rt/bf_rt_learn.hpp>
-#include <bf_rt/bf_rt_session.hpp>
-#include <bf_rt/bf_rt_table_attributes.hpp>
-#include <bf_rt/bf_rt_table_data.hpp>
-#include <bf_rt/bf_rt_table.hpp>
-#include <bf_rt/bf_rt_table_key.hpp>
-#include <bf_rt/bf_rt_table_operations.hpp>
-
-using namespace std;
-using namespace bfrt;
-
-class Meter{
-    private:
-        bf_status_t bf_status;
-        // keep session, dev_tgt since we need it in many funcs
-        shared_ptr<BfRtSession> session;
-        bf_rt_target_t dev_tgt;
-
-        // meter info
-        const BfRtTable *meter_table;
-
-        // for writing/reading data
-        unique_ptr<BfRtTableKey> _key;
-        unique_ptr<BfRtTableData> _data;
-        bf_rt_id_t meter_index_id;
-        bf_rt_id_t cir_pps_id, pir_pps_id, cbs_pkts_id, pbs_pkts_id;
-    public:
-        Meter(const string &name, shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
-
-        void add_entry(const uint32_t &avg_pkt_rate, const uint32_t &max_pkt_rate, const uint32_t &idx);
-};
-
-#endif
\ No newline at end of file
@@ -1,41 +0,0 @@
-#ifndef PORTSTABLE_H // Include guards to prevent multiple inclusion
-
-#define PORTSTABLE_H
-
-#include <bf_rt/bf_rt.hpp>
-#include <bf_rt/bf_rt_info.hpp>
-#include <bf_rt/bf_rt_init.hpp>
-#include <bf_rt/bf_rt_learn.hpp>
-#include <bf_rt/bf_rt_session.hpp>
-#include <bf_rt/bf_rt_table_attributes.hpp>
-#include <bf_rt/bf_rt_table_data.hpp>
-#include <bf_rt/bf_rt_table.hpp>
-#include <bf_rt/bf_rt_table_key.hpp>
-#include <bf_rt/bf_rt_table_operations.hpp>
-
-using namespace std;
-using namespace bfrt;
-
-class PortsTable{
-    private:
-        bf_status_t bf_status;
-        // keep session, dev_tgt since we need it in many funcs
-        shared_ptr<BfRtSession> session;
-        bf_rt_target_t dev_tgt;
-
-        const BfRtTable *ports_table;
-
-        // for writing/reading data
-        unique_ptr<BfRtTableKey> _key;
-        unique_ptr<BfRtTableData> _incoming_data, _outgoing_data;
-
-        // key/action ID
-        bf_rt_id_t incoming_action_id, outgoing_action_id;
-        bf_rt_id_t ingress_port_id;
-    public:
-        PortsTable(shared_ptr<BfRtSession> session, bf_rt_target_t dev_tgt, const BfRtInfo *bf_rt_info);
-
-        void add_entry(const uint16_t &port, bool direction);
-};
-
-#endif // PORTSTABLE_H
\ No newline at end of file